@@ -6,14 +6,23 @@
 
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <bit>
+#include <charconv>
+#include <cstdio>
 //#include <concepts>
 #include <exception>
 #include <initializer_list>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <new>
+#include <shared_mutex>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -80,11 +89,129 @@ namespace std{
 #define ___PRO_ENFORCE_EBO
 #endif  // _MSC_VER
 
+// Accessors and proxies odr-use their members in debug builds so that
+// debuggers can call them. Define PRO_DEBUG_SYMBOLS to 0 or 1 to decide
+// independently of NDEBUG; the choice must be the same in every translation
+// unit of a program.
+#ifndef PRO_DEBUG_SYMBOLS
 #ifdef NDEBUG
-#define ___PRO_DEBUG(...)
+#define PRO_DEBUG_SYMBOLS 0
 #else
-#define ___PRO_DEBUG(...) __VA_ARGS__
+#define PRO_DEBUG_SYMBOLS 1
 #endif  // NDEBUG
+#endif  // PRO_DEBUG_SYMBOLS
+
+#if PRO_DEBUG_SYMBOLS
+#define ___PRO_DEBUG(...) __VA_ARGS__
+#else
+#define ___PRO_DEBUG(...)
+#endif  // PRO_DEBUG_SYMBOLS
+
+// Indirect conventions invoke the object through a body shared by every
+// pointer type reaching it. By default the compiler inlines it wherever it
+// likes; define PRO_SHARED_DISPATCHERS to 1 to keep it out of line, so that
+// the dispatchers of T*, unique_ptr<T>, shared_ptr<T> etc. shrink to a load
+// and a jump, paid on each call. Must be the same in every translation unit.
+#ifndef PRO_SHARED_DISPATCHERS
+#define PRO_SHARED_DISPATCHERS 0
+#endif  // PRO_SHARED_DISPATCHERS
+
+#if !PRO_SHARED_DISPATCHERS
+#define ___PRO_SHARED_DISPATCHER
+#elif defined(_MSC_VER)
+#define ___PRO_SHARED_DISPATCHER __declspec(noinline)
+#else
+#define ___PRO_SHARED_DISPATCHER __attribute__((noinline))
+#endif  // PRO_SHARED_DISPATCHERS
+
+// Define PRO_DISPATCH_PROFILING to 1 to count the calls going through every
+// (facade, convention, concrete type), or to 2 to also add up the cycles they
+// take; see details::dispatch_profiler. Must be the same in every translation
+// unit.
+#ifndef PRO_DISPATCH_PROFILING
+#define PRO_DISPATCH_PROFILING 0
+#endif  // PRO_DISPATCH_PROFILING
+
+// Define PRO_DISPATCH_TRACING to N to trace one in every N calls going
+// through proxy_helper into per-thread ring buffers; see
+// details::dispatch_tracer. Must be the same in every translation unit.
+#ifndef PRO_DISPATCH_TRACING
+#define PRO_DISPATCH_TRACING 0
+#endif  // PRO_DISPATCH_TRACING
+
+// Define PRO_PERF_MAP to 1 to have registration remember the dispatchers of
+// every (facade, pointer type), so that static_meta_manager::write_perf_map
+// can name them. Must be the same in every translation unit.
+#ifndef PRO_PERF_MAP
+#define PRO_PERF_MAP 0
+#endif  // PRO_PERF_MAP
+
+#if PRO_DISPATCH_TRACING
+#include <chrono>
+#include <string>
+#if defined(_MSC_VER)
+#define ___PRO_COLD __declspec(noinline)
+#else
+#define ___PRO_COLD __attribute__((cold, noinline))
+#endif  // defined(_MSC_VER)
+#endif  // PRO_DISPATCH_TRACING
+
+#if PRO_DISPATCH_PROFILING > 1 || PRO_DISPATCH_TRACING
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_readcyclecounter)
+#define ___PRO_CYCLES() static_cast<std::uint64_t>(__builtin_readcyclecounter())
+#elif __has_builtin(__builtin_ia32_rdtsc)
+#define ___PRO_CYCLES() static_cast<std::uint64_t>(__builtin_ia32_rdtsc())
+#endif
+#endif
+#ifndef ___PRO_CYCLES
+#include <chrono>
+#define ___PRO_CYCLES() static_cast<std::uint64_t>( \
+    std::chrono::steady_clock::now().time_since_epoch().count())
+#endif  // ___PRO_CYCLES
+#endif  // PRO_DISPATCH_PROFILING > 1 || PRO_DISPATCH_TRACING
+
+#if PRO_PERF_MAP
+#include <fstream>
+#include <string>
+// Names the default perf map of the process, see
+// static_meta_manager::write_perf_map.
+#if defined(_WIN32)
+#include <process.h>
+#define ___PRO_GETPID() _getpid()
+#else
+#include <unistd.h>
+#define ___PRO_GETPID() getpid()
+#endif  // defined(_WIN32)
+#endif  // PRO_PERF_MAP
+
+// Proxies built from raw pointers or trivially copyable in-place values can
+// be constant-initialized; that needs to tell constant evaluation apart from
+// runtime, and to turn a value into bytes at compile time.
+#if defined(__cpp_lib_is_constant_evaluated)
+#define ___PRO_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#elif defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define ___PRO_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#endif
+#ifndef ___PRO_IS_CONSTANT_EVALUATED
+#define ___PRO_IS_CONSTANT_EVALUATED() false
+#endif  // ___PRO_IS_CONSTANT_EVALUATED
+
+#if defined(__cpp_lib_bit_cast)
+#define ___PRO_BIT_CAST(T, ...) std::bit_cast<T>(__VA_ARGS__)
+#elif defined(__has_builtin)
+#if __has_builtin(__builtin_bit_cast)
+#define ___PRO_BIT_CAST(T, ...) __builtin_bit_cast(T, __VA_ARGS__)
+#endif
+#endif
+
+#if __cpp_constexpr >= 201907L
+#define ___PRO_CONSTEXPR_DTOR constexpr
+#else
+#define ___PRO_CONSTEXPR_DTOR
+#endif  // __cpp_constexpr >= 201907L
 
 #define __msft_lib_proxy 202410L
 
@@ -92,28 +219,33 @@ namespace pro {
 
 enum class constraint_level { none, nontrivial, nothrow, trivial };
 
-template<std::size_t Tmax_size, std::size_t Tmax_align, constraint_level Tcopyability, constraint_level Trelocatability, constraint_level Tdestructibility>
+template<std::size_t Tmax_size, std::size_t Tmax_align, constraint_level Tcopyability, constraint_level Trelocatability, constraint_level Tdestructibility, std::size_t Tembedded_dispatchers = 0u>
 struct proxiable_ptr_constraints_t{
   template<std::size_t new_max_size>
-  using with_max_size = proxiable_ptr_constraints_t<new_max_size, Tmax_align, Tcopyability, Trelocatability, Tdestructibility>;
+  using with_max_size = proxiable_ptr_constraints_t<new_max_size, Tmax_align, Tcopyability, Trelocatability, Tdestructibility, Tembedded_dispatchers>;
 
   template<std::size_t new_max_align>
-  using with_max_align = proxiable_ptr_constraints_t<Tmax_size, new_max_align, Tcopyability, Trelocatability, Tdestructibility>;
+  using with_max_align = proxiable_ptr_constraints_t<Tmax_size, new_max_align, Tcopyability, Trelocatability, Tdestructibility, Tembedded_dispatchers>;
 
   template<constraint_level new_copyability>
-  using with_copyability = proxiable_ptr_constraints_t<Tmax_size, Tmax_align, new_copyability, Trelocatability, Tdestructibility>;
+  using with_copyability = proxiable_ptr_constraints_t<Tmax_size, Tmax_align, new_copyability, Trelocatability, Tdestructibility, Tembedded_dispatchers>;
 
   template<constraint_level new_relocatability>
-  using with_relocatability = proxiable_ptr_constraints_t<Tmax_size, Tmax_align, Tcopyability, new_relocatability, Tdestructibility>;
+  using with_relocatability = proxiable_ptr_constraints_t<Tmax_size, Tmax_align, Tcopyability, new_relocatability, Tdestructibility, Tembedded_dispatchers>;
 
   template<constraint_level new_destructibility>
-  using with_destructibility = proxiable_ptr_constraints_t<Tmax_size, Tmax_align, Tcopyability, Trelocatability, new_destructibility>;
+  using with_destructibility = proxiable_ptr_constraints_t<Tmax_size, Tmax_align, Tcopyability, Trelocatability, new_destructibility, Tembedded_dispatchers>;
+
+  template<std::size_t new_embedded_dispatchers>
+  using with_embedded_dispatchers = proxiable_ptr_constraints_t<Tmax_size, Tmax_align, Tcopyability, Trelocatability, Tdestructibility, new_embedded_dispatchers>;
 
   static constexpr auto max_size = Tmax_size;
   static constexpr auto max_align = Tmax_align;
   static constexpr auto copyability= Tcopyability;
   static constexpr auto relocatability= Trelocatability;
   static constexpr auto destructibility= Tdestructibility;
+  // Number of dispatchers copied into the proxy next to the meta pointer.
+  static constexpr auto embedded_dispatchers = Tembedded_dispatchers;
 };
 
 struct proxiable_ptr_constraints {
@@ -150,14 +282,87 @@ using add_qualifier_t = typename add_qualifier_traits<T, Q>::type;
 template <class T, qualifier_type Q>
 using add_qualifier_ptr_t = std::remove_reference_t<add_qualifier_t<T, Q>>*;
 
+// Element I of a pack: the compiler builtin where there is one, otherwise
+// deduced from an indexed base, one instantiation per list rather than a
+// recursion per lookup.
+template <std::size_t I, class L> struct type_at;
+#if defined(__has_builtin)
+#if __has_builtin(__type_pack_element)
+#define ___PRO_HAS_TYPE_PACK_ELEMENT
+#endif
+#endif
+#ifdef ___PRO_HAS_TYPE_PACK_ELEMENT
+template <std::size_t I, class... Ts>
+struct type_at<I, std::tuple<Ts...>>
+    : std::type_identity<__type_pack_element<I, Ts...>> {};
+#undef ___PRO_HAS_TYPE_PACK_ELEMENT
+#else
+template <std::size_t I, class T> struct indexed_type : std::type_identity<T> {};
+template <class Is, class... Ts> struct indexed_types;
+template <std::size_t... Is, class... Ts>
+struct indexed_types<std::index_sequence<Is...>, Ts...>
+    : indexed_type<Is, Ts>... {};
+template <std::size_t I, class T>
+indexed_type<I, T> type_at_impl(const indexed_type<I, T>*);
+template <std::size_t I, class... Ts>
+struct type_at<I, std::tuple<Ts...>> : decltype(details::type_at_impl<I>(
+    static_cast<indexed_types<std::index_sequence_for<Ts...>, Ts...>*>(
+        nullptr))) {};
+#endif
+template <std::size_t I, class L>
+using type_at_t = typename type_at<I, L>::type;
+
+// Left fold of R over Is. Each step refers to the inputs by index into one
+// shared tuple, so the steps do not carry the remaining tail along and the
+// total size of the instantiated argument lists stays linear.
+template <template <class, class> class R, class O, class L, std::size_t I,
+    std::size_t N>
+struct indexed_reduction : indexed_reduction<
+    R, R<O, type_at_t<I, L>>, L, I + 1u, N> {};
+template <template <class, class> class R, class O, class L, std::size_t N>
+struct indexed_reduction<R, O, L, N, N> : std::type_identity<O> {};
 template <template <class, class> class R, class O, class... Is>
-struct recursive_reduction : std::type_identity<O> {};
-template <template <class, class> class R, class O, class I, class... Is>
-struct recursive_reduction<R, O, I, Is...>
-    : recursive_reduction<R, R<O, I>, Is...> {};
+struct recursive_reduction
+    : indexed_reduction<R, O, std::tuple<Is...>, 0u, sizeof...(Is)> {};
 template <template <class, class> class R, class O, class... Is>
 using recursive_reduction_t = typename recursive_reduction<R, O, Is...>::type;
 
+// Concatenation of the packs of Ls (all instances of one template L) in a
+// single expansion: element K of the result is element inner[K] of list
+// outer[K], both computed by a constexpr loop.
+template <std::size_t... Ns>
+struct flatten_indices {
+  static constexpr std::size_t size = (Ns + ... + 0u);
+  static constexpr auto make() noexcept {
+    constexpr std::size_t counts[] = {Ns..., 0u};
+    std::array<std::size_t, size + 1u> outer{}, inner{};
+    std::size_t k = 0u;
+    for (std::size_t i = 0u; i < sizeof...(Ns); ++i) {
+      for (std::size_t j = 0u; j < counts[i]; ++j, ++k) {
+        outer[k] = i;
+        inner[k] = j;
+      }
+    }
+    return std::pair{outer, inner};
+  }
+  static constexpr auto value = make();
+};
+template <template <class...> class L, class Ls, class Ix, class Ks>
+struct flatten_impl;
+template <template <class...> class L, class Ls, class Ix, std::size_t... Ks>
+struct flatten_impl<L, Ls, Ix, std::index_sequence<Ks...>>
+    : std::type_identity<L<type_at_t<Ix::value.second[Ks],
+          type_at_t<Ix::value.first[Ks], Ls>>...>> {};
+template <class T> struct list_as_tuple;
+template <template <class...> class L, class... Ts>
+struct list_as_tuple<L<Ts...>> : std::type_identity<std::tuple<Ts...>> {};
+template <template <class...> class L, class... Ls>
+using flatten_t = typename flatten_impl<L,
+    std::tuple<typename list_as_tuple<Ls>::type...>,
+    flatten_indices<std::tuple_size_v<typename list_as_tuple<Ls>::type>...>,
+    std::make_index_sequence<flatten_indices<
+        std::tuple_size_v<typename list_as_tuple<Ls>::type>...>::size>>::type;
+
 template<typename... Args>
 struct template_args_count;
 template<>
@@ -290,25 +495,91 @@ R invoke_dispatch(Args&&... args) {
     return D{}(std::forward<Args>(args)...);
   }
 }
+template <class T> class inplace_ptr;
+template <class P> constexpr bool is_inplace_ptr = false;
+template <class T> constexpr bool is_inplace_ptr<inplace_ptr<T>> = true;
+template <class P>
+constexpr bool is_object_ptr = std::is_pointer_v<P> &&
+    std::is_object_v<std::remove_pointer_t<P>>;
+
+// A proxy constant-initialized from an object pointer holds it as void*, not
+// as an object of type P, so such pointers are read through the object
+// representation both share. Non-const access first turns it into a P.
+template <class P>
+P load_object_ptr(const std::byte& self) noexcept {
+  P result;
+  std::memcpy(&result, &self, sizeof(P));
+  return result;
+}
+template <class P>
+void materialize_object_ptr(std::byte& self) noexcept
+    { std::construct_at(reinterpret_cast<P*>(&self), load_object_ptr<P>(self)); }
+
+// The qualifier of std::byte that refers to the same object as Ref.
+template <class Ref>
+constexpr qualifier_type ref_qualifier_v = std::is_rvalue_reference_v<Ref>
+    ? (std::is_const_v<std::remove_reference_t<Ref>>
+        ? qualifier_type::const_rv : qualifier_type::rv)
+    : (std::is_const_v<std::remove_reference_t<Ref>>
+        ? qualifier_type::const_lv : qualifier_type::lv);
+
+// Invokes D on the object that self refers to, as Ref. It depends on the
+// object type only, so every pointer type reaching the same object shares
+// one body: inplace_ptr holds the object at its own address and uses it as
+// the dispatcher, other pointer types forward to it once dereferenced.
+template <class D, class Ref, class R, class... Args>
+___PRO_SHARED_DISPATCHER R object_conv_dispatcher(
+    add_qualifier_t<std::byte, ref_qualifier_v<Ref>> self, Args... args)
+    noexcept(invocable_dispatch<D, true, R, Ref, Args...>) {
+  return invoke_dispatch<D, R>(static_cast<Ref>(*std::launder(
+      reinterpret_cast<std::remove_reference_t<Ref>*>(&self))),
+      std::forward<Args>(args)...);
+}
 template <class D, class P, qualifier_type Q, class R, class... Args>
 R indirect_conv_dispatcher(add_qualifier_t<std::byte, Q> self, Args... args)
     noexcept(invocable_dispatch_ptr_indirect<D, P, Q, true, R, Args...>) {
-  return invoke_dispatch<D, R>(*std::forward<add_qualifier_t<P, Q>>(
-      *std::launder(reinterpret_cast<add_qualifier_ptr_t<P, Q>>(&self))),
-      std::forward<Args>(args)...);
+  using Ref = decltype(*std::declval<add_qualifier_t<P, Q>>());
+  if constexpr (std::is_reference_v<Ref> &&
+      std::is_object_v<std::remove_reference_t<Ref>>) {
+    constexpr qualifier_type RQ = ref_qualifier_v<Ref>;
+    auto&& obj = [&]() -> Ref {
+      if constexpr (is_object_ptr<P>) {
+        return *load_object_ptr<P>(self);
+      } else {
+        return *std::forward<add_qualifier_t<P, Q>>(*std::launder(
+            reinterpret_cast<add_qualifier_ptr_t<P, Q>>(&self)));
+      }
+    }();
+    return object_conv_dispatcher<D, Ref, R, Args...>(
+        std::forward<add_qualifier_t<std::byte, RQ>>(*reinterpret_cast<
+            add_qualifier_ptr_t<std::byte, RQ>>(std::addressof(obj))),
+        std::forward<Args>(args)...);
+  } else {
+    return invoke_dispatch<D, R>(*std::forward<add_qualifier_t<P, Q>>(
+        *std::launder(reinterpret_cast<add_qualifier_ptr_t<P, Q>>(&self))),
+        std::forward<Args>(args)...);
+  }
 }
 template <class D, class P, qualifier_type Q, class R, class... Args>
 R direct_conv_dispatcher(add_qualifier_t<std::byte, Q> self, Args... args)
     noexcept(invocable_dispatch_ptr_direct<D, P, Q, true, R, Args...>) {
-  auto& qp = *std::launder(
-      reinterpret_cast<add_qualifier_ptr_t<P, Q>>(&self));
-  if constexpr (Q == qualifier_type::rv) {
-    destruction_guard guard{&qp};
+  if constexpr (is_object_ptr<P> && (Q == qualifier_type::const_lv ||
+      Q == qualifier_type::const_rv)) {
+    const P p = load_object_ptr<P>(self);
     return invoke_dispatch<D, R>(
-        std::forward<add_qualifier_t<P, Q>>(qp), std::forward<Args>(args)...);
+        std::forward<add_qualifier_t<P, Q>>(p), std::forward<Args>(args)...);
   } else {
-    return invoke_dispatch<D, R>(
-        std::forward<add_qualifier_t<P, Q>>(qp), std::forward<Args>(args)...);
+    if constexpr (is_object_ptr<P>) { materialize_object_ptr<P>(self); }
+    auto& qp = *std::launder(
+        reinterpret_cast<add_qualifier_ptr_t<P, Q>>(&self));
+    if constexpr (Q == qualifier_type::rv) {
+      destruction_guard guard{&qp};
+      return invoke_dispatch<D, R>(std::forward<add_qualifier_t<P, Q>>(qp),
+          std::forward<Args>(args)...);
+    } else {
+      return invoke_dispatch<D, R>(std::forward<add_qualifier_t<P, Q>>(qp),
+          std::forward<Args>(args)...);
+    }
   }
 }
 template <class D, qualifier_type Q, class R, class... Args>
@@ -318,8 +589,12 @@ R default_conv_dispatcher(add_qualifier_t<std::byte, Q>, Args... args)
 template <class P>
 void copying_dispatcher(std::byte& self, const std::byte& rhs)
     noexcept(has_copyability<P>(constraint_level::nothrow)) {
-  std::construct_at(reinterpret_cast<P*>(&self),
-      *std::launder(reinterpret_cast<const P*>(&rhs)));
+  if constexpr (is_object_ptr<P>) {
+    std::construct_at(reinterpret_cast<P*>(&self), load_object_ptr<P>(rhs));
+  } else {
+    std::construct_at(reinterpret_cast<P*>(&self),
+        *std::launder(reinterpret_cast<const P*>(&rhs)));
+  }
 }
 template <std::size_t Len, std::size_t Align>
 void copying_default_dispatcher(std::byte& self, const std::byte& rhs)
@@ -330,14 +605,22 @@ void copying_default_dispatcher(std::byte& self, const std::byte& rhs)
 template <class P>
 void relocation_dispatcher(std::byte& self, const std::byte& rhs)
     noexcept(has_relocatability<P>(constraint_level::nothrow)) {
-  P* other = std::launder(reinterpret_cast<P*>(const_cast<std::byte*>(&rhs)));
-  destruction_guard guard{other};
-  std::construct_at(reinterpret_cast<P*>(&self), std::move(*other));
+  if constexpr (is_object_ptr<P>) {
+    std::construct_at(reinterpret_cast<P*>(&self), load_object_ptr<P>(rhs));
+  } else {
+    P* other = std::launder(
+        reinterpret_cast<P*>(const_cast<std::byte*>(&rhs)));
+    destruction_guard guard{other};
+    std::construct_at(reinterpret_cast<P*>(&self), std::move(*other));
+  }
 }
 template <class P>
 void destruction_dispatcher(std::byte& self)
-    noexcept(has_destructibility<P>(constraint_level::nothrow))
-    { std::destroy_at(std::launder(reinterpret_cast<P*>(&self))); }
+    noexcept(has_destructibility<P>(constraint_level::nothrow)) {
+  if constexpr (!is_object_ptr<P>) {
+    std::destroy_at(std::launder(reinterpret_cast<P*>(&self)));
+  }
+}
 inline void destruction_default_dispatcher(std::byte&) noexcept {}
 
 template <class O> struct overload_traits : inapplicable_traits {};
@@ -348,7 +631,11 @@ struct overload_traits_impl : applicable_traits {
     template <class P>
     static constexpr auto get()
         -> func_ptr_t<NE, R, add_qualifier_t<std::byte, Q>, Args...> {
-      if constexpr (!IsDirect &&
+      if constexpr (!IsDirect && is_inplace_ptr<P> &&
+          invocable_dispatch_ptr_indirect<D, P, Q, NE, R, Args...>) {
+        return &object_conv_dispatcher<D,
+            decltype(*std::declval<add_qualifier_t<P, Q>>()), R, Args...>;
+      } else if constexpr (!IsDirect &&
           invocable_dispatch_ptr_indirect<D, P, Q, NE, R, Args...>) {
         return &indirect_conv_dispatcher<D, P, Q, R, Args...>;
       } else if constexpr (IsDirect &&
@@ -427,31 +714,20 @@ struct composite_meta_impl : Ms... {
       : Ms(std::in_place_type<P>)... {}
 };
 
-// Remove I if I is void
-template<typename I, typename... Ms>
-struct meta_reduction_helper{
-  template<typename II>
-  static auto test(std::type_identity<II>*, typename std::enable_if<!std::is_void_v<II>, int>::type) -> composite_meta_impl<Ms..., I>;
-  static auto test(...) -> composite_meta_impl<Ms...>;
-
-  using type = decltype(test((std::type_identity<I> *)nullptr, 0));
-};
-
-template <class O, class I> struct meta_reduction : std::type_identity<O> {};
-template <class... Ms, class I>
-struct meta_reduction<composite_meta_impl<Ms...>, I>
-    : std::type_identity<typename meta_reduction_helper<I, Ms...>::type> {};
-template <class... Ms1, class... Ms2>
-struct meta_reduction<composite_meta_impl<Ms1...>, composite_meta_impl<Ms2...>>
-    : std::type_identity<composite_meta_impl<Ms1..., Ms2...>> {};
-
-
-template <class O, class I>
-using meta_reduction_t = typename meta_reduction<O, I>::type;
+// Each meta as a list to splice: void contributes nothing and a composite
+// contributes its parts.
+template <class M>
+struct meta_reduction_helper
+    : std::type_identity<composite_meta_impl<M>> {};
+template <>
+struct meta_reduction_helper<void>
+    : std::type_identity<composite_meta_impl<>> {};
 template <class... Ms>
-using composite_meta =
-    recursive_reduction_t<meta_reduction_t, composite_meta_impl<>, Ms...>;
-
+struct meta_reduction_helper<composite_meta_impl<Ms...>>
+    : std::type_identity<composite_meta_impl<Ms...>> {};
+template <class... Ms>
+using composite_meta = flatten_t<composite_meta_impl,
+    typename meta_reduction_helper<Ms>::type...>;
 
 template <class C, class... Os>
 struct conv_traits_impl_applic : applicable_traits {
@@ -462,6 +738,17 @@ struct conv_traits_impl_applic : applicable_traits {
   static constexpr bool applicable_ptr =
       (overload_traits<Os>::template applicable_ptr<
           C::is_direct, typename C::dispatch_type, P> && ...);
+#if PRO_PERF_MAP
+  // Calls v(type_identity<C>, type_identity<O>, address) with the dispatcher
+  // of every overload O for the pointer type P.
+  template <class P, class V>
+  static void visit_dispatchers(V& v) {
+    (v(std::type_identity<C>{}, std::type_identity<Os>{},
+        reinterpret_cast<const void*>(overload_traits<Os>::template
+            meta_provider<C::is_direct, typename C::dispatch_type>
+            ::template get<P>())), ...);
+  }
+#endif  // PRO_PERF_MAP
 };
 
 template<class C, class... Os>
@@ -609,34 +896,16 @@ struct accessor_traits<std::void_t<typename T::template accessor<F>>, T, F>
 template <class T, class F>
 using accessor_t = typename accessor_traits<void, T, F>::type;
 
-template<bool IsDirect, class F, class O, class I, bool is_direct = (IsDirect == I::is_direct && !std::is_void_v<accessor_t<I, F>>)>
-struct composite_accessor_reduction_helpers;
-
-template <bool IsDirect, class F, class O, class I>
-struct composite_accessor_reduction_helpers<IsDirect, F, O, I, false>{
-  using type = std::type_identity<O>;
-};
-
-template <bool IsDirect, class F, class... As, class I>
-struct composite_accessor_reduction_helpers<IsDirect, F, composite_accessor_impl<As...>, I, true>{
-  using type = std::type_identity<composite_accessor_impl<As..., accessor_t<I, F>>>;
-};
-
-
-template <bool IsDirect, class F, class O, class I>
-struct composite_accessor_reduction : composite_accessor_reduction_helpers<IsDirect, F, O, I>::type {};
-
-
-template <bool IsDirect, class F>
-struct composite_accessor_helper {
-  template <class O, class I>
-  using reduction_t =
-      typename composite_accessor_reduction<IsDirect, F, O, I>::type;
-};
+template <bool IsDirect, class F, class I, bool Applicable = (IsDirect ==
+    I::is_direct && !std::is_void_v<accessor_t<I, F>>)>
+struct composite_accessor_reduction
+    : std::type_identity<composite_accessor_impl<>> {};
+template <bool IsDirect, class F, class I>
+struct composite_accessor_reduction<IsDirect, F, I, true>
+    : std::type_identity<composite_accessor_impl<accessor_t<I, F>>> {};
 template <bool IsDirect, class F, class... Ts>
-using composite_accessor = recursive_reduction_t<
-      composite_accessor_helper<IsDirect, F>::template reduction_t,
-      composite_accessor_impl<>, Ts...>;
+using composite_accessor = flatten_t<composite_accessor_impl,
+    typename composite_accessor_reduction<IsDirect, F, Ts>::type...>;
 
 template <class A1, class A2> struct composite_accessor_merge_traits;
 template <class... A1, class... A2>
@@ -664,15 +933,39 @@ constexpr bool is_facade_constraints_well_formed() {
   return false;
 }
 
+template <class C, class = void> struct hot_conv_traits : inapplicable_traits {};
+template <class C>
+struct hot_conv_traits<C, std::enable_if_t<C::is_hot>> : applicable_traits {};
+template <class C>
+constexpr bool is_hot_conv = hot_conv_traits<C>::applicable;
+
+// Empty base that raises the alignment of a meta table to a cache line.
+struct alignas(64) cache_line_meta {
+  constexpr cache_line_meta() noexcept = default;
+  template <class P>
+  constexpr explicit cache_line_meta(std::in_place_type_t<P>) noexcept {}
+};
+
 template <class F, class... Cs>
 struct facade_conv_traits_impl_appli : applicable_traits {
   using conv_meta = composite_meta<typename conv_traits<Cs>::meta...>;
+  using hot_dispatcher_meta = composite_meta<std::conditional_t<
+      is_hot_conv<Cs>, typename conv_traits<Cs>::meta, void>...>;
+  using hot_conv_meta = composite_meta<std::conditional_t<(is_hot_conv<Cs> ||
+      ...), cache_line_meta, void>, hot_dispatcher_meta>;
+  using cold_conv_meta = composite_meta<std::conditional_t<is_hot_conv<Cs>,
+      void, typename conv_traits<Cs>::meta>...>;
   using conv_indirect_accessor = composite_accessor<false, F, Cs...>;
   using conv_direct_accessor = composite_accessor<true, F, Cs...>;
 
   template <class P>
   static constexpr bool conv_applicable_ptr =
       (conv_traits<Cs>::template applicable_ptr<P> && ...);
+#if PRO_PERF_MAP
+  template <class P, class V>
+  static void visit_dispatchers(V& v)
+      { (conv_traits<Cs>::template visit_dispatchers<P>(v), ...); }
+#endif  // PRO_PERF_MAP
   template <bool IsDirect, class D, class O>
   static constexpr bool is_invocable = std::is_base_of_v<dispatcher_meta<
       typename overload_traits<O>::template meta_provider<IsDirect, D>>,
@@ -714,6 +1007,43 @@ template <class F, class... Rs>
 struct facade_refl_traits_impl : facade_refl_traits_impl_helpers<F, Rs...>::type {};
 
 struct poly_cast_meta;
+template <class M> struct meta_ptr_indirect_impl;
+template <class M, class E> struct meta_ptr_embedded_impl;
+template <class F, class M> struct meta_ptr_sealed_impl;
+template <class M> struct meta_ptr_traits_helpers;
+template <class M>
+using meta_ptr = typename meta_ptr_traits_helpers<M>::type;
+
+template <class C, class = void>
+struct embedded_dispatchers_traits
+    : std::integral_constant<std::size_t, 0u> {};
+template <class C>
+struct embedded_dispatchers_traits<C,
+    std::void_t<decltype(C::embedded_dispatchers)>>
+    : std::integral_constant<std::size_t, C::embedded_dispatchers> {};
+template <class C>
+constexpr std::size_t embedded_dispatchers_of =
+    embedded_dispatchers_traits<C>::value;
+
+template <class F, class = void>
+struct sealed_types_traits : std::type_identity<std::tuple<>> {};
+template <class F>
+struct sealed_types_traits<F, std::void_t<typename F::sealed_types>>
+    : std::type_identity<typename F::sealed_types> {};
+template <class F>
+using sealed_types_of = typename sealed_types_traits<F>::type;
+
+// Keeps the first N metas of a composite meta.
+template <std::size_t N, class O, class I>
+struct meta_take_traits : std::type_identity<O> {};
+template <std::size_t N, class... Os, class I, class... Is>
+struct meta_take_traits<N, composite_meta_impl<Os...>,
+    composite_meta_impl<I, Is...>>
+    : std::conditional_t<N == 0u, std::type_identity<composite_meta_impl<Os...>>,
+          meta_take_traits<N - 1u, composite_meta_impl<Os..., I>,
+              composite_meta_impl<Is...>>> {};
+template <std::size_t N, class M>
+using meta_take_t = typename meta_take_traits<N, composite_meta_impl<>, M>::type;
 
 template <class F>
 struct facade_traits_applic
@@ -727,9 +1057,21 @@ struct facade_traits_applic
           constraint_level::trivial : F::constraints::relocatability>;
   using destructibility_meta = lifetime_meta_t<
       destructibility_meta_provider, F::constraints::destructibility>;
-  using meta = composite_meta<poly_cast_meta, copyability_meta, relocatability_meta,
-      destructibility_meta, typename facade_traits_applic::conv_meta,
+  // Hot dispatchers go first, right after the cache line aligned base, so a
+  // single line fill brings all of them in.
+  using meta = composite_meta<typename facade_traits_applic::hot_conv_meta,
+      poly_cast_meta, copyability_meta, relocatability_meta,
+      destructibility_meta, typename facade_traits_applic::cold_conv_meta,
       typename facade_traits_applic::refl_meta>;
+  using meta_ptr_type = std::conditional_t<
+      (std::tuple_size_v<sealed_types_of<F>> > 0u),
+      meta_ptr_sealed_impl<F, meta>, std::conditional_t<
+      (embedded_dispatchers_of<typename F::constraints> > 0u),
+      meta_ptr_embedded_impl<meta, meta_take_t<
+          embedded_dispatchers_of<typename F::constraints>, composite_meta<
+              typename facade_traits_applic::hot_dispatcher_meta,
+              typename facade_traits_applic::cold_conv_meta>>>,
+      meta_ptr<meta>>>;
   using indirect_accessor = merged_composite_accessor<
       typename facade_traits_applic::conv_indirect_accessor,
       typename facade_traits_applic::refl_indirect_accessor>;
@@ -772,17 +1114,46 @@ struct meta_ptr_indirect_impl {
   void reset() noexcept { ptr_ = nullptr; }
   const M* operator->() const noexcept { return ptr_; }
   const M* get_ptr() const noexcept {return ptr_; }
+  template <class P>
+  bool holds() const noexcept { return ptr_ == &storage<P>; }
+  const void* identity() const noexcept { return ptr_; }
 
  private:
   const M* ptr_;
   template <class P> static constexpr M storage{std::in_place_type<P>};
 };
+template <class M> constexpr bool is_dispatcher_meta = false;
+template <class MP>
+constexpr bool is_dispatcher_meta<dispatcher_meta<MP>> = true;
+
+// Whether two metas hold the same dispatchers. Other parts of the metas, and
+// the padding between them, take no part.
+template <class... Ms>
+bool same_dispatchers(const composite_meta_impl<Ms...>& lhs,
+    const composite_meta_impl<Ms...>& rhs) noexcept {
+  return ([&] {
+    if constexpr (is_dispatcher_meta<Ms>) {
+      return static_cast<const Ms&>(lhs).dispatcher ==
+          static_cast<const Ms&>(rhs).dispatcher;
+    } else {
+      return true;
+    }
+  }() && ...);
+}
+
 template <class M, class DM>
 struct meta_ptr_direct_impl : private M {
   using M::M;
   bool has_value() const noexcept { return this->DM::dispatcher != nullptr; }
   void reset() noexcept { this->DM::dispatcher = nullptr; }
   const M* operator->() const noexcept { return this; }
+  template <class P>
+  bool holds() const noexcept {
+    constexpr M expected{std::in_place_type<P>};
+    return same_dispatchers(static_cast<const M&>(*this), expected);
+  }
+  // Metas stored by value have no address shared between proxies.
+  const void* identity() const noexcept { return nullptr; }
 };
 
 
@@ -807,8 +1178,38 @@ struct meta_ptr_traits_helpers{
   using type = decltype(test((std::type_identity<M> *)nullptr));
 };
 
-template <class M>
-using meta_ptr = typename meta_ptr_traits_helpers<M>::type;
+// Fat meta pointer: besides the meta table it carries copies of the
+// dispatchers in E, saving one dependent load on their invocation.
+template <class M, class... DMs>
+struct meta_ptr_embedded_impl<M, composite_meta_impl<DMs...>> : DMs... {
+  constexpr meta_ptr_embedded_impl() noexcept = default;
+  meta_ptr_embedded_impl(const std::byte* ptr) noexcept
+      : DMs(static_cast<const DMs&>(*reinterpret_cast<const M*>(ptr)))...,
+        meta_(ptr) {}
+  template <class P>
+  constexpr explicit meta_ptr_embedded_impl(std::in_place_type_t<P>) noexcept
+      : DMs(std::in_place_type<P>)..., meta_(std::in_place_type<P>) {}
+  bool has_value() const noexcept { return meta_.has_value(); }
+  void reset() noexcept { meta_.reset(); }
+  const M* operator->() const noexcept { return meta_.operator->(); }
+  const M* get_ptr() const noexcept { return meta_.get_ptr(); }
+  template <class P>
+  bool holds() const noexcept { return meta_.template holds<P>(); }
+  const void* identity() const noexcept { return meta_.identity(); }
+
+ private:
+  meta_ptr_indirect_impl<M> meta_;
+};
+
+template <class MP, class DM>
+constexpr bool embeds_dispatcher = false;
+template <class M, class... DMs, class DM>
+constexpr bool embeds_dispatcher<meta_ptr_embedded_impl<M,
+    composite_meta_impl<DMs...>>, DM> = (std::is_same_v<DM, DMs> || ...);
+template <class MP>
+constexpr bool is_sealed_meta_ptr = false;
+template <class F, class M>
+constexpr bool is_sealed_meta_ptr<meta_ptr_sealed_impl<F, M>> = true;
 
 
 struct static_type_token_impl{
@@ -816,18 +1217,28 @@ struct static_type_token_impl{
     using remove_qualifiers = typename std::remove_const<typename std::remove_reference<T>::type>::type;
 
     std::string_view type_name;
+    // FNV-1a of type_name; identical in every translation unit, so it can
+    // order tables that are built at compile time.
+    std::uint64_t hash;
 
     bool operator ==(const static_type_token_impl& rhs) const noexcept{
         return type_name == rhs.type_name;
     }
     explicit operator size_t() const noexcept{
-        return std::hash<std::string_view>{}(type_name);
+        return static_cast<size_t>(hash);
     }
 
-    constexpr static_type_token_impl() noexcept: type_name("<none>")  {
+    constexpr static_type_token_impl() noexcept: type_name("<none>"), hash(hash_name(type_name))  {
     }
     template <class P>
-    explicit constexpr static_type_token_impl(std::in_place_type_t<P>) noexcept : type_name(make_buffer<remove_qualifiers<P>>())  {
+    explicit constexpr static_type_token_impl(std::in_place_type_t<P>) noexcept : type_name(make_buffer<remove_qualifiers<P>>()), hash(hash_name(type_name))  {
+    }
+    static constexpr std::uint64_t hash_name(std::string_view name) noexcept{
+        std::uint64_t result = 14695981039346656037ull;
+        for (char c : name) {
+            result = (result ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+        }
+        return result;
     }
     template<typename T>
     static constexpr std::string_view make_buffer(){
@@ -854,13 +1265,15 @@ struct static_type_token{
   template<typename T>
   constexpr static_type_token(std::in_place_type_t<T>) noexcept : token_ptr(&token<T>){
   }
+  constexpr explicit static_type_token(const static_type_token_impl* token) noexcept : token_ptr(token){
+  }
 
   const static_type_token_impl* token_ptr;
 
   static constexpr static_type_token_impl null_type{};
   template<typename T> static constexpr static_type_token_impl token{std::in_place_type<T>};
 
-  const static_type_token_impl *operator->() const noexcept{
+  constexpr const static_type_token_impl *operator->() const noexcept{
     return token_ptr;
   }
 
@@ -874,6 +1287,661 @@ struct static_type_token{
 
 
 
+#if PRO_DISPATCH_PROFILING || PRO_DISPATCH_TRACING
+// A convention of a facade, as invoked through proxy_helper.
+struct dispatch_profile_site {
+  static_type_token facade_type;
+  static_type_token dispatch_type;
+  static_type_token overload_type;
+  bool is_direct;
+};
+template <class F, bool IsDirect, class D, class O>
+inline constexpr dispatch_profile_site dispatch_profile_site_v{
+    static_type_token{std::in_place_type<F>},
+    static_type_token{std::in_place_type<D>},
+    static_type_token{std::in_place_type<O>}, IsDirect};
+#endif  // PRO_DISPATCH_PROFILING || PRO_DISPATCH_TRACING
+
+#if PRO_DISPATCH_PROFILING
+// Calls (and cycles) per site and concrete type. Each thread counts into its
+// own shard without synchronization; the shards are only locked to add a
+// key or to be read, and are kept until the next reset() once their thread
+// exits. Recording never throws: a call that would need memory the shard
+// cannot get is dropped().
+struct dispatch_profiler {
+  struct entry{
+    static_type_token facade_type;
+    static_type_token dispatch_type;
+    static_type_token overload_type;
+    bool is_direct;
+    // As keyed in static_meta_manager: the value of inplace and allocated
+    // storage, the pointer type itself otherwise (e.g. "Rect *").
+    static_type_token proxiable_type;
+    std::uint64_t calls;
+    // Always 0 unless PRO_DISPATCH_PROFILING is 2.
+    std::uint64_t cycles;
+  };
+  struct profile_report{
+    std::uint64_t total_calls;
+    // Merged by type name across shards; grouped by facade and convention,
+    // most called type first within each.
+    std::vector<entry> entries;
+  };
+
+  static void record(const dispatch_profile_site& site,
+      const static_type_token& type, [[maybe_unused]] std::uint64_t cycles) noexcept {
+    shard* sh = local_shard();
+    slot* s = sh == nullptr ? nullptr : sh->find(&site, type.token_ptr);
+    if(s == nullptr){
+      dropped_count.fetch_add(1u, std::memory_order_relaxed);
+      return;
+    }
+    s->calls.store(s->calls.load(std::memory_order_relaxed) + 1u,
+        std::memory_order_relaxed);
+#if PRO_DISPATCH_PROFILING > 1
+    s->cycles.store(s->cycles.load(std::memory_order_relaxed) + cycles,
+        std::memory_order_relaxed);
+#endif  // PRO_DISPATCH_PROFILING > 1
+  }
+  // Calls left uncounted for lack of memory.
+  static std::uint64_t dropped() noexcept
+      { return dropped_count.load(std::memory_order_relaxed); }
+
+  static profile_report report(){
+    std::vector<entry> all;
+    {
+      std::lock_guard<std::mutex> lock{shards_mutex};
+      for(shard* s : {shards, retired}){
+        for(; s != nullptr; s = s->next){
+          s->collect(all);
+        }
+      }
+    }
+    auto name_less = [](const entry& lhs, const entry& rhs){
+      auto key = [](const entry& e){
+        return std::make_tuple(e.facade_type->type_name, e.dispatch_type->type_name,
+            e.overload_type->type_name, !e.is_direct, e.proxiable_type->type_name);
+      };
+      return key(lhs) < key(rhs);
+    };
+    std::sort(all.begin(), all.end(), name_less);
+    profile_report result{};
+    for(auto& e : all){
+      result.total_calls += e.calls;
+      if(!result.entries.empty() && !name_less(result.entries.back(), e)){
+        result.entries.back().calls += e.calls;
+        result.entries.back().cycles += e.cycles;
+      }else{
+        result.entries.push_back(e);
+      }
+    }
+    std::stable_sort(result.entries.begin(), result.entries.end(), [](const entry& lhs, const entry& rhs){
+      if(!same_site(lhs, rhs)){
+        return std::make_tuple(lhs.facade_type->type_name, lhs.dispatch_type->type_name,
+            lhs.overload_type->type_name, !lhs.is_direct) <
+            std::make_tuple(rhs.facade_type->type_name, rhs.dispatch_type->type_name,
+            rhs.overload_type->type_name, !rhs.is_direct);
+      }
+      return lhs.calls > rhs.calls;
+    });
+    return result;
+  }
+
+  // Prints one line per convention, with the share of its most called type,
+  // followed by one line per concrete type.
+  static void dump(std::ostream& os = std::cout){
+    profile_report r = report();
+    os << "dispatch profile: " << r.total_calls << " calls\n";
+    for(auto first = r.entries.begin(); first != r.entries.end();){
+      auto last = std::find_if(first, r.entries.end(),
+          [&](const entry& e){ return !same_site(*first, e); });
+      std::uint64_t calls = 0u;
+      for(auto it = first; it != last; ++it){
+        calls += it->calls;
+      }
+      os << "  " << first->facade_type->type_name << " :: "
+          << first->dispatch_type->type_name << (first->is_direct ? " [direct] " : " ")
+          << first->overload_type->type_name << ": " << calls << " calls, "
+          << (last - first) << " types, top " << percent(first->calls, calls) << "%\n";
+      for(; first != last; ++first){
+        os << "    " << first->proxiable_type->type_name << ": " << first->calls
+            << " calls (" << percent(first->calls, calls) << "%)";
+        if(first->cycles != 0u){
+          os << ", " << static_cast<double>(first->cycles) / first->calls << " cycles/call";
+        }
+        os << "\n";
+      }
+    }
+  }
+
+  // Counts racing with a reset may survive it.
+  static void reset(){
+    std::lock_guard<std::mutex> lock{shards_mutex};
+    while(retired != nullptr){
+      delete std::exchange(retired, retired->next);
+    }
+    for(shard* s = shards; s != nullptr; s = s->next){
+      s->clear();
+    }
+    dropped_count.store(0u, std::memory_order_relaxed);
+  }
+
+ private:
+  struct slot{
+    const dispatch_profile_site* site;
+    const static_type_token_impl* type;
+    std::atomic<std::uint64_t> calls;
+    std::atomic<std::uint64_t> cycles;
+  };
+  // An open addressing table, written by its thread only.
+  struct shard{
+    std::mutex mutex;
+    std::unique_ptr<slot[]> slots;
+    std::size_t capacity = 0u;
+    std::size_t size = 0u;
+    // Next in shards or retired; guarded by shards_mutex.
+    shard* next = nullptr;
+
+    // nullptr if the key is new and the table cannot grow to take it.
+    slot* find(const dispatch_profile_site* site, const static_type_token_impl* type) noexcept{
+      for(std::size_t i = index(site, type);; i = (i + 1u) & (capacity - 1u)){
+        slot& s = slots[i];
+        if(s.site == site && s.type == type){
+          return &s;
+        }
+        if(s.site == nullptr){
+          break;
+        }
+      }
+      std::lock_guard<std::mutex> lock{mutex};
+      if(2u * (size + 1u) > capacity && !grow(capacity * 2u)){
+        return nullptr;
+      }
+      std::size_t i = index(site, type);
+      while(slots[i].site != nullptr){
+        i = (i + 1u) & (capacity - 1u);
+      }
+      ++size;
+      slots[i].site = site;
+      slots[i].type = type;
+      return &slots[i];
+    }
+    void collect(std::vector<entry>& out){
+      std::lock_guard<std::mutex> lock{mutex};
+      for(std::size_t i = 0u; i < capacity; ++i){
+        const slot& s = slots[i];
+        if(s.site != nullptr && s.calls.load(std::memory_order_relaxed) != 0u){
+          out.push_back(entry{s.site->facade_type, s.site->dispatch_type,
+              s.site->overload_type, s.site->is_direct, static_type_token{s.type},
+              s.calls.load(std::memory_order_relaxed),
+              s.cycles.load(std::memory_order_relaxed)});
+        }
+      }
+    }
+    void clear(){
+      std::lock_guard<std::mutex> lock{mutex};
+      for(std::size_t i = 0u; i < capacity; ++i){
+        slots[i].calls.store(0u, std::memory_order_relaxed);
+        slots[i].cycles.store(0u, std::memory_order_relaxed);
+      }
+    }
+
+   private:
+    std::size_t index(const dispatch_profile_site* site, const static_type_token_impl* type) const noexcept{
+      std::uint64_t h = (reinterpret_cast<std::uintptr_t>(site) >> 3) * 0x9e3779b97f4a7c15ull ^ type->hash;
+      return static_cast<std::size_t>(h ^ (h >> 32)) & (capacity - 1u);
+    }
+   public:
+    // Leaves the table as it is if the memory cannot be had.
+    bool grow(std::size_t new_capacity) noexcept{
+      std::unique_ptr<slot[]> fresh{new (std::nothrow) slot[new_capacity]()};
+      if(fresh == nullptr){
+        return false;
+      }
+      std::size_t old_capacity = std::exchange(capacity, new_capacity);
+      std::unique_ptr<slot[]> old = std::exchange(slots, std::move(fresh));
+      for(std::size_t i = 0u; i < old_capacity; ++i){
+        if(old[i].site != nullptr){
+          std::size_t j = index(old[i].site, old[i].type);
+          while(slots[j].site != nullptr){
+            j = (j + 1u) & (capacity - 1u);
+          }
+          slots[j].site = old[i].site;
+          slots[j].type = old[i].type;
+          slots[j].calls.store(old[i].calls.load(std::memory_order_relaxed), std::memory_order_relaxed);
+          slots[j].cycles.store(old[i].cycles.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+      }
+      return true;
+    }
+  };
+  // Moves the shard of its thread to retired when the thread exits.
+  struct shard_owner{
+    shard* owned = nullptr;
+
+    ~shard_owner(){
+      if(owned == nullptr){
+        return;
+      }
+      std::lock_guard<std::mutex> lock{shards_mutex};
+      shard** link = &shards;
+      while(*link != owned){
+        link = &(*link)->next;
+      }
+      *link = owned->next;
+      owned->next = std::exchange(retired, owned);
+    }
+  };
+
+  // Made with room for 8 keys on the first call of a thread; nullptr if
+  // that memory cannot be had.
+  static shard* local_shard() noexcept{
+    thread_local shard_owner owner;
+    if(owner.owned == nullptr){
+      std::unique_ptr<shard> s{new (std::nothrow) shard{}};
+      if(s == nullptr || !s->grow(16u)){
+        return nullptr;
+      }
+      std::lock_guard<std::mutex> lock{shards_mutex};
+      s->next = std::exchange(shards, s.get());
+      owner.owned = s.release();
+    }
+    return owner.owned;
+  }
+  static bool same_site(const entry& lhs, const entry& rhs) noexcept{
+    return lhs.facade_type->type_name == rhs.facade_type->type_name &&
+        lhs.dispatch_type->type_name == rhs.dispatch_type->type_name &&
+        lhs.overload_type->type_name == rhs.overload_type->type_name &&
+        lhs.is_direct == rhs.is_direct;
+  }
+  static double percent(std::uint64_t part, std::uint64_t whole) noexcept{
+    return whole == 0u ? 0.0 : 100.0 * static_cast<double>(part) / static_cast<double>(whole);
+  }
+
+  inline static std::mutex shards_mutex{};
+  inline static shard* shards = nullptr;
+  // Shards of the threads that have exited.
+  inline static shard* retired = nullptr;
+  inline static std::atomic<std::uint64_t> dropped_count{0u};
+};
+
+// Records one call on destruction, so that the count survives exceptions
+// and the cycles span the whole dispatch.
+class dispatch_profile_scope {
+ public:
+  dispatch_profile_scope(const dispatch_profile_site& site,
+      const static_type_token& type) noexcept : site_(site), type_(type)
+#if PRO_DISPATCH_PROFILING > 1
+      , start_(___PRO_CYCLES())
+#endif  // PRO_DISPATCH_PROFILING > 1
+      {}
+  dispatch_profile_scope(const dispatch_profile_scope&) = delete;
+  ~dispatch_profile_scope() noexcept {
+#if PRO_DISPATCH_PROFILING > 1
+    dispatch_profiler::record(site_, type_, ___PRO_CYCLES() - start_);
+#else
+    dispatch_profiler::record(site_, type_, 0u);
+#endif  // PRO_DISPATCH_PROFILING > 1
+  }
+
+ private:
+  const dispatch_profile_site& site_;
+  static_type_token type_;
+#if PRO_DISPATCH_PROFILING > 1
+  std::uint64_t start_;
+#endif  // PRO_DISPATCH_PROFILING > 1
+};
+#endif  // PRO_DISPATCH_PROFILING
+
+#if PRO_DISPATCH_TRACING
+// Traces sampled calls: one in every sample_period() calls of a thread is
+// written, without locking, to a ring buffer of that thread. drain() takes
+// the records of all threads out; the binary form it writes to a stream can
+// be turned into the JSON of the Chrome trace event format. Recording never
+// throws: a thread whose buffer cannot be allocated loses its records.
+struct dispatch_tracer {
+  struct trace_record{
+    // steady_clock nanoseconds, converted from cycles when drained.
+    std::uint64_t start;
+    std::uint64_t duration;
+    const dispatch_profile_site* site;
+    // As in dispatch_profiler::entry.
+    static_type_token proxiable_type;
+    // Numbered from 0 in the order threads first trace a call.
+    std::uint32_t thread;
+  };
+  // Records kept per thread between two drains; older ones are overwritten
+  // and counted as lost.
+  static constexpr std::size_t capacity = 4096u;
+
+  static std::uint32_t sample_period() noexcept
+      { return period.load(std::memory_order_relaxed); }
+  static void set_sample_period(std::uint32_t n) noexcept
+      { period.store(n == 0u ? 1u : n, std::memory_order_relaxed); }
+
+  static bool sample() noexcept{
+    thread_local std::uint32_t countdown = 1u;
+    if(--countdown != 0u){
+      return false;
+    }
+    countdown = period.load(std::memory_order_relaxed);
+    return true;
+  }
+  static std::uint64_t now() noexcept { return ___PRO_CYCLES(); }
+  static void record(const dispatch_profile_site& site,
+      const static_type_token& type, std::uint64_t start, std::uint64_t end) noexcept{
+    if(buffer* b = local_buffer(); b != nullptr){
+      b->push(site, type, start, end - start);
+    }else{
+      unstored_count.fetch_add(1u, std::memory_order_relaxed);
+    }
+  }
+
+  // Takes the records of every thread out, oldest first.
+  static std::vector<trace_record> drain(){
+    std::vector<trace_record> result;
+    clock_point start;
+    {
+      std::lock_guard<std::mutex> lock{buffers_mutex};
+      start = origin;
+      for(buffer* b = buffers; b != nullptr; b = b->next){
+        b->drain(result);
+      }
+      while(retired != nullptr){
+        retired->drain(result);
+        delete std::exchange(retired, retired->next);
+      }
+    }
+    std::stable_sort(result.begin(), result.end(), [](const trace_record& lhs, const trace_record& rhs){
+      return lhs.start < rhs.start;
+    });
+    // Nanoseconds per cycle, as measured since the first buffer was made.
+    clock_point end = clock_point::current();
+    double rate = 1.0;
+    if(end.cycles > start.cycles && end.nanoseconds > start.nanoseconds){
+      rate = static_cast<double>(end.nanoseconds - start.nanoseconds) / static_cast<double>(end.cycles - start.cycles);
+    }
+    for(auto& r : result){
+      // The first record of a program is started before origin is taken.
+      auto offset = static_cast<double>(static_cast<std::int64_t>(r.start - start.cycles)) * rate;
+      r.start = start.nanoseconds + static_cast<std::uint64_t>(static_cast<std::int64_t>(offset));
+      r.duration = static_cast<std::uint64_t>(static_cast<double>(r.duration) * rate);
+    }
+    return result;
+  }
+  // Appends the drained records to os as one chunk: the names they use, then
+  // the records referring to them by index, in native byte order.
+  static void drain(std::ostream& os){
+    std::vector<trace_record> records = drain();
+    std::vector<std::string_view> names;
+    std::unordered_map<std::string_view, std::uint32_t> indices;
+    auto index_of = [&](const static_type_token& t){
+      auto [iter, inserted] = indices.try_emplace(t->type_name, static_cast<std::uint32_t>(names.size()));
+      if(inserted){
+        names.push_back(t->type_name);
+      }
+      return iter->second;
+    };
+    std::vector<std::array<std::uint32_t, 6u>> fields;
+    for(auto& r : records){
+      fields.push_back({r.thread, index_of(r.site->facade_type), index_of(r.site->dispatch_type),
+          index_of(r.site->overload_type), index_of(r.proxiable_type), r.site->is_direct ? 1u : 0u});
+    }
+    os.write(chunk_magic, sizeof(chunk_magic));
+    write_value(os, static_cast<std::uint32_t>(names.size()));
+    for(auto name : names){
+      write_value(os, static_cast<std::uint32_t>(name.size()));
+      os.write(name.data(), static_cast<std::streamsize>(name.size()));
+    }
+    write_value(os, static_cast<std::uint64_t>(records.size()));
+    for(std::size_t i = 0u; i < records.size(); ++i){
+      write_value(os, records[i].start);
+      write_value(os, records[i].duration);
+      for(std::uint32_t f : fields[i]){
+        write_value(os, f);
+      }
+    }
+  }
+  // Records overwritten before they could be drained, or never stored for
+  // lack of a buffer.
+  static std::uint64_t lost(){
+    std::lock_guard<std::mutex> lock{buffers_mutex};
+    return lost_count + unstored_count.load(std::memory_order_relaxed);
+  }
+
+  // Converts the chunks written by drain(std::ostream&) to one "complete"
+  // event per record, named "Facade::Dispatch<Type>". Returns false if the
+  // input is malformed. The counts in the input are checked against the
+  // bytes left in is where it can tell, and names are read piecewise, so
+  // that a corrupt count cannot make it allocate more than the input holds.
+  static bool convert_to_chrome_trace(std::istream& is, std::ostream& os){
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true, valid = true;
+    while(valid && is.peek() != std::istream::traits_type::eof()){
+      char magic[sizeof(chunk_magic)];
+      std::uint32_t name_count = 0u;
+      valid = static_cast<bool>(is.read(magic, sizeof(magic))) &&
+          std::equal(magic, magic + sizeof(magic), chunk_magic) && read_value(is, name_count) &&
+          name_count <= remaining(is) / sizeof(std::uint32_t);
+      std::vector<std::string> names;
+      for(std::uint32_t i = 0u; valid && i < name_count; ++i){
+        std::uint32_t size = 0u;
+        valid = read_value(is, size) && size <= remaining(is) &&
+            read_string(is, size, names.emplace_back());
+      }
+      std::uint64_t record_count = 0u;
+      valid = valid && read_value(is, record_count) &&
+          record_count <= remaining(is) / (2u * sizeof(std::uint64_t) + 6u * sizeof(std::uint32_t));
+      for(std::uint64_t i = 0u; valid && i < record_count; ++i){
+        std::uint64_t start = 0u, duration = 0u;
+        std::uint32_t f[6u] = {};
+        valid = read_value(is, start) && read_value(is, duration);
+        for(auto& x : f){
+          valid = valid && read_value(is, x);
+        }
+        valid = valid && f[1] < names.size() && f[2] < names.size() && f[3] < names.size() && f[4] < names.size();
+        if(!valid){
+          break;
+        }
+        os << (first ? "\n" : ",\n") << "{\"name\":";
+        first = false;
+        write_json_string(os, names[f[1]] + "::" + names[f[2]] + "<" + names[f[4]] + ">");
+        os << ",\"cat\":\"proxy\",\"ph\":\"X\",\"pid\":0,\"tid\":" << f[0]
+            << ",\"ts\":" << start / 1000u << "." << static_cast<char>('0' + start / 100u % 10u)
+            << static_cast<char>('0' + start / 10u % 10u) << static_cast<char>('0' + start % 10u)
+            << ",\"dur\":" << duration / 1000u << "." << static_cast<char>('0' + duration / 100u % 10u)
+            << static_cast<char>('0' + duration / 10u % 10u) << static_cast<char>('0' + duration % 10u)
+            << ",\"args\":{\"overload\":";
+        write_json_string(os, names[f[3]]);
+        os << ",\"direct\":" << (f[5] != 0u ? "true" : "false") << "}}";
+      }
+    }
+    os << "\n]}\n";
+    return valid;
+  }
+
+ private:
+  // A record guarded by its sequence: the index it holds plus one once
+  // written, 0 while being written.
+  struct slot{
+    std::atomic<std::uint64_t> sequence;
+    std::atomic<std::uint64_t> start;
+    std::atomic<std::uint64_t> duration;
+    std::atomic<const dispatch_profile_site*> site;
+    std::atomic<const static_type_token_impl*> type;
+  };
+  // Written by its thread only; drained under buffers_mutex.
+  struct buffer{
+    std::unique_ptr<slot[]> slots;
+    std::atomic<std::uint64_t> head{0u};
+    std::uint64_t tail = 0u;
+    std::uint32_t thread = 0u;
+    // Next in buffers or retired; guarded by buffers_mutex.
+    buffer* next = nullptr;
+
+    void push(const dispatch_profile_site& site, const static_type_token& type,
+        std::uint64_t start, std::uint64_t duration) noexcept{
+      std::uint64_t i = head.load(std::memory_order_relaxed);
+      slot& s = slots[i & (capacity - 1u)];
+      s.sequence.store(0u, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      s.start.store(start, std::memory_order_relaxed);
+      s.duration.store(duration, std::memory_order_relaxed);
+      s.site.store(&site, std::memory_order_relaxed);
+      s.type.store(type.token_ptr, std::memory_order_relaxed);
+      s.sequence.store(i + 1u, std::memory_order_release);
+      head.store(i + 1u, std::memory_order_release);
+    }
+    void drain(std::vector<trace_record>& out){
+      std::uint64_t last = head.load(std::memory_order_acquire);
+      std::uint64_t first = std::max(tail, last > capacity ? last - capacity : 0u);
+      lost_count += first - tail;
+      for(std::uint64_t i = first; i < last; ++i){
+        const slot& s = slots[i & (capacity - 1u)];
+        std::uint64_t sequence = s.sequence.load(std::memory_order_acquire);
+        trace_record r{s.start.load(std::memory_order_relaxed), s.duration.load(std::memory_order_relaxed),
+            s.site.load(std::memory_order_relaxed), static_type_token{s.type.load(std::memory_order_relaxed)}, thread};
+        std::atomic_thread_fence(std::memory_order_acquire);
+        // Overwritten by the thread meanwhile.
+        if(sequence != i + 1u || s.sequence.load(std::memory_order_relaxed) != sequence){
+          ++lost_count;
+          continue;
+        }
+        out.push_back(r);
+      }
+      tail = last;
+    }
+  };
+  struct clock_point{
+    std::uint64_t cycles;
+    std::uint64_t nanoseconds;
+
+    static clock_point current() noexcept{
+      return clock_point{___PRO_CYCLES(), static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count())};
+    }
+  };
+  // Moves the buffer of its thread to retired when the thread exits; the
+  // next drain() takes its records and frees it.
+  struct buffer_owner{
+    buffer* owned = nullptr;
+
+    ~buffer_owner(){
+      if(owned == nullptr){
+        return;
+      }
+      std::lock_guard<std::mutex> lock{buffers_mutex};
+      buffer** link = &buffers;
+      while(*link != owned){
+        link = &(*link)->next;
+      }
+      *link = owned->next;
+      owned->next = std::exchange(retired, owned);
+    }
+  };
+
+  // Made on the first traced call of a thread; nullptr if that memory cannot
+  // be had.
+  static buffer* local_buffer() noexcept{
+    thread_local buffer_owner owner;
+    if(owner.owned == nullptr){
+      std::unique_ptr<buffer> b{new (std::nothrow) buffer{}};
+      if(b == nullptr){
+        return nullptr;
+      }
+      b->slots.reset(new (std::nothrow) slot[capacity]());
+      if(b->slots == nullptr){
+        return nullptr;
+      }
+      std::lock_guard<std::mutex> lock{buffers_mutex};
+      if(next_thread == 0u){
+        origin = clock_point::current();
+      }
+      b->thread = next_thread++;
+      b->next = std::exchange(buffers, b.get());
+      owner.owned = b.release();
+    }
+    return owner.owned;
+  }
+  template <class T>
+  static void write_value(std::ostream& os, T value){
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+  template <class T>
+  static bool read_value(std::istream& is, T& value){
+    return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(T)));
+  }
+  // Grows s only as far as is actually holds the bytes.
+  static bool read_string(std::istream& is, std::size_t size, std::string& s){
+    char buffer[256];
+    while(size != 0u){
+      std::size_t n = std::min(size, sizeof(buffer));
+      if(!is.read(buffer, static_cast<std::streamsize>(n))){
+        return false;
+      }
+      s.append(buffer, n);
+      size -= n;
+    }
+    return true;
+  }
+  // Bytes left in is, or the largest count when is cannot seek.
+  static std::uint64_t remaining(std::istream& is){
+    auto here = is.tellg();
+    if(here == std::istream::pos_type(-1)){
+      return std::numeric_limits<std::uint64_t>::max();
+    }
+    is.seekg(0, std::ios::end);
+    auto end = is.tellg();
+    is.clear();
+    is.seekg(here);
+    return end == std::istream::pos_type(-1) || end < here ?
+        std::numeric_limits<std::uint64_t>::max() : static_cast<std::uint64_t>(end - here);
+  }
+  static void write_json_string(std::ostream& os, std::string_view text){
+    static constexpr char hex[] = "0123456789abcdef";
+    os << '"';
+    for(char c : text){
+      if(c == '"' || c == '\\'){
+        os << '\\' << c;
+      }else if(static_cast<unsigned char>(c) < 0x20u){
+        os << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+      }else{
+        os << c;
+      }
+    }
+    os << '"';
+  }
+
+  static constexpr char chunk_magic[8] = {'P', 'R', 'O', 'T', 'R', 'A', 'C', 'E'};
+  inline static std::atomic<std::uint32_t> period{PRO_DISPATCH_TRACING};
+  inline static std::mutex buffers_mutex{};
+  inline static buffer* buffers = nullptr;
+  inline static std::uint32_t next_thread = 0u;
+  inline static std::uint64_t lost_count = 0u;
+  inline static std::atomic<std::uint64_t> unstored_count{0u};
+  inline static clock_point origin{};
+  // Buffers of the threads that have exited.
+  inline static buffer* retired = nullptr;
+};
+
+// Traces a sampled call on destruction, so that calls leaving by an
+// exception are traced as well.
+class dispatch_trace_scope {
+ public:
+  dispatch_trace_scope(const dispatch_profile_site& site,
+      const static_type_token& type) noexcept
+      : site_(site), type_(type), start_(dispatch_tracer::now()) {}
+  dispatch_trace_scope(const dispatch_trace_scope&) = delete;
+  ~dispatch_trace_scope() noexcept
+      { dispatch_tracer::record(site_, type_, start_, dispatch_tracer::now()); }
+
+ private:
+  const dispatch_profile_site& site_;
+  static_type_token type_;
+  std::uint64_t start_;
+};
+#endif  // PRO_DISPATCH_TRACING
+
 template <class MP>
 struct meta_ptr_reset_guard {
  public:
@@ -891,11 +1959,73 @@ struct proxy_helper {
     assert((std::ignore = "proxy probably have been dumped" , p.has_value()));
     return *p.meta_.operator->();
   }
+  template <class MP>
+  static auto get_dispatcher(const proxy<F>& p) noexcept {
+    if constexpr (embeds_dispatcher<decltype(p.meta_), dispatcher_meta<MP>>) {
+      assert((std::ignore = "proxy probably have been dumped" , p.has_value()));
+      return static_cast<const dispatcher_meta<MP>&>(p.meta_).dispatcher;
+    } else {
+      return get_meta(p).template dispatcher_meta<MP>::dispatcher;
+    }
+  }
   template <bool IsDirect, class D, class O, qualifier_type Q, class... Args>
   static decltype(auto) invoke(add_qualifier_t<proxy<F>, Q> p, Args&&... args) {
-    auto dispatcher = get_meta(p)
-        .template dispatcher_meta<typename overload_traits<O>
-        ::template meta_provider<IsDirect, D>>::dispatcher;
+#if PRO_DISPATCH_PROFILING
+    dispatch_profile_scope scope{dispatch_profile_site_v<F, IsDirect, D, O>,
+        get_meta(p).poly_cast_meta::proxiable_type};
+#endif  // PRO_DISPATCH_PROFILING
+#if PRO_DISPATCH_TRACING
+    if (dispatch_tracer::sample()) {
+      return traced_invoke<IsDirect, D, O, Q>(
+          std::forward<add_qualifier_t<proxy<F>, Q>>(p),
+          std::forward<Args>(args)...);
+    }
+#endif  // PRO_DISPATCH_TRACING
+    return dispatch<IsDirect, D, O, Q>(
+        std::forward<add_qualifier_t<proxy<F>, Q>>(p),
+        std::forward<Args>(args)...);
+  }
+#if PRO_DISPATCH_TRACING
+  // Out of line, so that the calls not sampled only pay for sample().
+  template <bool IsDirect, class D, class O, qualifier_type Q, class... Args>
+  ___PRO_COLD static decltype(auto) traced_invoke(
+      add_qualifier_t<proxy<F>, Q> p, Args&&... args) {
+    dispatch_trace_scope trace{dispatch_profile_site_v<F, IsDirect, D, O>,
+        get_meta(p).poly_cast_meta::proxiable_type};
+    return dispatch<IsDirect, D, O, Q>(
+        std::forward<add_qualifier_t<proxy<F>, Q>>(p),
+        std::forward<Args>(args)...);
+  }
+#endif  // PRO_DISPATCH_TRACING
+  template <bool IsDirect, class D, class O, qualifier_type Q, class... Args>
+  static decltype(auto) dispatch(add_qualifier_t<proxy<F>, Q> p, Args&&... args) {
+    using MP = typename overload_traits<O>
+        ::template meta_provider<IsDirect, D>;
+    if constexpr (is_sealed_meta_ptr<decltype(p.meta_)>) {
+      assert((std::ignore = "proxy probably have been dumped" , p.has_value()));
+      return p.meta_.visit([&](auto t) -> decltype(auto) {
+        constexpr auto dispatcher =
+            MP::template get<typename decltype(t)::type>();
+        return call<IsDirect, O, Q>(dispatcher,
+            std::forward<add_qualifier_t<proxy<F>, Q>>(p),
+            std::forward<Args>(args)...);
+      });
+    } else {
+      return call<IsDirect, O, Q>(get_dispatcher<MP>(p),
+          std::forward<add_qualifier_t<proxy<F>, Q>>(p),
+          std::forward<Args>(args)...);
+    }
+  }
+  static std::byte& storage(const proxy<F>& p) noexcept
+      { return const_cast<std::byte&>(*p.ptr_); }
+  template <class P>
+  static bool holds(const proxy<F>& p) noexcept
+      { return p.meta_.template holds<P>(); }
+  static const void* meta_identity(const proxy<F>& p) noexcept
+      { return p.meta_.identity(); }
+  template <bool IsDirect, class O, qualifier_type Q, class DP, class... Args>
+  static decltype(auto) call(DP dispatcher, add_qualifier_t<proxy<F>, Q> p,
+      Args&&... args) {
     if constexpr (
         IsDirect && overload_traits<O>::qualifier == qualifier_type::rv) {
       meta_ptr_reset_guard guard{p.meta_};
@@ -979,6 +2109,144 @@ namespace details{
   template <class T, class Alloc>
   class compact_ptr;
 
+  // Views of the storage of a proxy that a constant expression is able to
+  // initialize: raw pointers are kept as void*, trivially copyable in-place
+  // values as their object representation. Either way the bytes are those of
+  // the pointer type; object pointers are therefore only ever read through
+  // them (see load_object_ptr).
+  struct empty_storage {};
+  template <std::size_t N>
+  struct storage_image { std::byte bytes[N]; };
+  template <class T, std::size_t N, bool Padded = (N > sizeof(T))>
+  struct padded_value { T value; std::byte padding[N - sizeof(T)] = {}; };
+  template <class T, std::size_t N>
+  struct padded_value<T, N, false> { T value; };
+
+  struct raw_storage_init {};
+  struct image_storage_init {};
+  struct generic_storage_init {};
+
+  template <std::size_t N, std::size_t A>
+  constexpr bool has_raw_storage = sizeof(void*) <= N && alignof(void*) <= A;
+  template <class P, std::size_t N, std::size_t A>
+  constexpr bool is_raw_storable = is_object_ptr<P> && has_raw_storage<N, A>;
+  template <class P, std::size_t N>
+  constexpr bool is_image_storable() {
+#ifdef ___PRO_BIT_CAST
+    if constexpr (is_inplace_ptr<P>) {
+      using T = typename P::type;
+      if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= N) {
+        return sizeof(padded_value<T, N>) == N;
+      }
+    }
+#endif  // ___PRO_BIT_CAST
+    return false;
+  }
+  template <class P, class F>
+  using storage_init_t = std::conditional_t<is_raw_storable<P,
+      F::constraints::max_size, F::constraints::max_align>, raw_storage_init,
+      std::conditional_t<is_image_storable<P, F::constraints::max_size>(),
+          image_storage_init, generic_storage_init>>;
+
+  template <class T>
+  constexpr void* erase_object_ptr(T* ptr) noexcept
+      { return const_cast<void*>(static_cast<const volatile void*>(ptr)); }
+#ifdef ___PRO_BIT_CAST
+  template <std::size_t N, class T, class... Args>
+  constexpr storage_image<N> make_storage_image(Args&&... args) {
+    return ___PRO_BIT_CAST(storage_image<N>,
+        padded_value<T, N>{T(std::forward<Args>(args)...)});
+  }
+#endif  // ___PRO_BIT_CAST
+
+  // Candidate pointer types of a sealed facade: every sealed type stored
+  // inline, behind the default allocator or behind a raw pointer, restricted
+  // to the ones that are actually proxiable.
+  template <class F, class... Ts>
+  struct sealed_ptr_types_impl {
+    template <class P>
+    using keep = std::conditional_t<proxiable<P, F>, std::tuple<P>, std::tuple<>>;
+    using type = decltype(std::tuple_cat(
+        std::declval<keep<inplace_ptr<Ts>>>()...,
+        std::declval<keep<allocated_ptr<Ts, std::allocator<Ts>>>>()...,
+        std::declval<keep<Ts*>>()...));
+  };
+  template <class F, class Ts> struct sealed_ptr_types;
+  template <class F, class... Ts>
+  struct sealed_ptr_types<F, std::tuple<Ts...>>
+      : sealed_ptr_types_impl<F, Ts...> {};
+
+  template <class M, class Ps> struct meta_ptr_sealed_base;
+  // Stores the 1-based position of the pointer type in Ps instead of a meta
+  // pointer; 0 means empty. Invocations switch over the index and call the
+  // dispatcher of the selected type directly, the meta table is only used
+  // for lifetime management, casts and reflection.
+  template <class M, class... Ps>
+  struct meta_ptr_sealed_base<M, std::tuple<Ps...>> {
+    static_assert(sizeof...(Ps) > 0u, "None of the sealed types is proxiable");
+    using index_type = std::conditional_t<
+        (sizeof...(Ps) < 255u), std::uint8_t, std::uint16_t>;
+
+    constexpr meta_ptr_sealed_base() noexcept : index_(0u) {}
+    meta_ptr_sealed_base(const std::byte* ptr) noexcept : index_(0u) {
+      for (std::size_t i = 1u; i <= sizeof...(Ps); ++i) {
+        if (reinterpret_cast<const std::byte*>(table()[i]) == ptr)
+            { index_ = static_cast<index_type>(i); break; }
+      }
+    }
+    template <class P>
+    constexpr explicit meta_ptr_sealed_base(std::in_place_type_t<P>) noexcept
+        : index_(index_of<P>) {
+      static_assert(index_of<P> != 0u,
+          "P is not a pointer type of the sealed facade");
+    }
+    bool has_value() const noexcept { return index_ != 0u; }
+    void reset() noexcept { index_ = 0u; }
+    const M* operator->() const noexcept { return table()[index_]; }
+    const M* get_ptr() const noexcept { return table()[index_]; }
+    template <class P>
+    bool holds() const noexcept
+        { return index_of<P> != 0u && index_ == index_of<P>; }
+    const void* identity() const noexcept { return table()[index_]; }
+    std::size_t index() const noexcept { return index_; }
+
+    // Calls v(std::type_identity<P>{}) with the held pointer type.
+    template <std::size_t I = 0u, class V>
+    decltype(auto) visit(V&& v) const {
+      using P = std::tuple_element_t<I, std::tuple<Ps...>>;
+      if constexpr (I + 1u == sizeof...(Ps)) {
+        return v(std::type_identity<P>{});
+      } else {
+        if (index_ == I + 1u) { return v(std::type_identity<P>{}); }
+        return visit<I + 1u>(std::forward<V>(v));
+      }
+    }
+
+   private:
+    template <class P>
+    static constexpr std::size_t index_of = [] {
+      std::size_t result = 0u, i = 0u;
+      ((++i, result = (result == 0u && std::is_same_v<P, Ps>) ? i : result),
+          ...);
+      return result;
+    }();
+    static const M* const* table() noexcept {
+      static constexpr const M* result[] = {nullptr, &storage<Ps>...};
+      return result;
+    }
+    template <class P> static constexpr M storage{std::in_place_type<P>};
+
+    index_type index_;
+  };
+
+  template <class F, class M>
+  struct meta_ptr_sealed_impl : meta_ptr_sealed_base<
+      M, typename sealed_ptr_types<F, sealed_types_of<F>>::type> {
+    using meta_ptr_sealed_base<
+        M, typename sealed_ptr_types<F, sealed_types_of<F>>::type>
+        ::meta_ptr_sealed_base;
+  };
+
 
   template<class P>
   struct get_object_fn_collections;
@@ -1025,30 +2293,253 @@ namespace details{
     {
       std::size_t operator()(const meta_key& k) const
       {
-        return static_cast<std::size_t>(k.facade_type) ^ static_cast<std::size_t>(k.proxiable_type);
+        return static_cast<std::size_t>(k.facade_type->hash ^ (k.proxiable_type->hash * 1099511628211ull));
+      }
+    };
+
+    using meta_map_type = std::unordered_map<meta_key, std::vector<meta_info>, type_token_hasher>;
+    // Built on first use: meta_registrar registers from dynamic initializers,
+    // which may run before those of this header's inline variables.
+    static meta_map_type& meta_map(){
+      static meta_map_type result;
+      return result;
+    }
+    // Proxies may be constructed and cast concurrently (e.g. tasks submitted
+    // from worker threads): registration takes the lock exclusively, lookups
+    // share it so that concurrent casts do not serialize.
+    inline static std::shared_mutex meta_map_mutex{};
+#if PRO_PERF_MAP
+    struct dispatcher_symbol{
+      const void* address;
+      // "Facade::Dispatch<Type> Overload", with Type as in meta_key.
+      std::string name;
+    };
+    // One per registered (facade, pointer type); guarded by meta_map_mutex.
+    static std::vector<void (*)(std::vector<dispatcher_symbol>&)>& symbol_sources(){
+      static std::vector<void (*)(std::vector<dispatcher_symbol>&)> result;
+      return result;
+    }
+
+    template<class P, class F>
+    static void collect_symbols(std::vector<dispatcher_symbol>& out){
+      static_type_token facade{std::in_place_type<F>};
+      static_type_token type{std::in_place_type<typename get_object_fn_collections<P>::value_type>};
+      auto visitor = [&](auto c, auto o, const void* address){
+        static_type_token dispatch{std::in_place_type<typename decltype(c)::type::dispatch_type>};
+        static_type_token overload{std::in_place_type<typename decltype(o)::type>};
+        std::string name{facade->type_name};
+        name.append("::").append(dispatch->type_name).append("<").append(type->type_name)
+            .append("> ").append(overload->type_name);
+        out.push_back(dispatcher_symbol{address, std::move(name)});
+      };
+      facade_traits<F>::template visit_dispatchers<P>(visitor);
+    }
+#endif  // PRO_PERF_MAP
+#ifdef PRO_REGISTRY_STATISTICS
+    // Lookups per key, including misses and those a precomputed registry
+    // serves; guarded by meta_map_mutex. The macro must be defined alike in
+    // every translation unit.
+    inline static std::unordered_map<meta_key, std::size_t, type_token_hasher> lookup_counts{};
+#endif  // PRO_REGISTRY_STATISTICS
+
+    struct key_stats{
+      static_type_token facade_type;
+      static_type_token proxiable_type;
+      // Entries in the runtime registry; 0 for a key that was only looked
+      // up, whether the lookup missed or a precomputed registry served it.
+      std::size_t entries;
+      // Always 0 unless PRO_REGISTRY_STATISTICS is defined.
+      std::size_t lookups;
+    };
+    struct registry_stats{
+      std::size_t key_count;
+      std::size_t entry_count;
+      std::size_t bucket_count;
+      float load_factor;
+      // Length of the bucket chain a lookup walks: the longest one, and the
+      // mean over all registered keys.
+      std::size_t max_probe_length;
+      double mean_probe_length;
+      // Estimate of the heap held by the registry: buckets, nodes and
+      // entry vectors.
+      std::size_t total_bytes;
+      // The registered keys, and with PRO_REGISTRY_STATISTICS the other
+      // looked-up ones as well. Most looked-up keys first, then by facade and
+      // type name.
+      std::vector<key_stats> keys;
+    };
+
+    static registry_stats stats(){
+      std::shared_lock<std::shared_mutex> lock{meta_map_mutex};
+      auto& map = meta_map();
+      registry_stats result{};
+      result.key_count = map.size();
+      result.bucket_count = map.bucket_count();
+      result.load_factor = map.load_factor();
+      result.total_bytes = map.bucket_count() * sizeof(void*) + map.size() *
+          (sizeof(std::pair<const meta_key, std::vector<meta_info>>) + 2u * sizeof(void*));
+      std::size_t probes = 0u;
+      for(auto& [key, infos] : map){
+        std::size_t chain = map.bucket_size(map.bucket(key));
+        probes += chain;
+        result.max_probe_length = std::max(result.max_probe_length, chain);
+        result.entry_count += infos.size();
+        result.total_bytes += infos.capacity() * sizeof(meta_info);
+        std::size_t lookups = 0u;
+#ifdef PRO_REGISTRY_STATISTICS
+        if(auto iter = lookup_counts.find(key); iter != lookup_counts.end()){
+          lookups = iter->second;
+        }
+#endif  // PRO_REGISTRY_STATISTICS
+        result.keys.push_back(key_stats{key.facade_type, key.proxiable_type, infos.size(), lookups});
+      }
+#ifdef PRO_REGISTRY_STATISTICS
+      for(auto& [key, lookups] : lookup_counts){
+        if(map.find(key) == map.end()){
+          result.keys.push_back(key_stats{key.facade_type, key.proxiable_type, 0u, lookups});
+        }
+      }
+#endif  // PRO_REGISTRY_STATISTICS
+      if(result.key_count != 0u){
+        result.mean_probe_length = static_cast<double>(probes) / result.key_count;
+      }
+      std::sort(result.keys.begin(), result.keys.end(), [](const key_stats& lhs, const key_stats& rhs){
+        if(lhs.lookups != rhs.lookups){
+          return lhs.lookups > rhs.lookups;
+        }
+        if(lhs.facade_type->type_name != rhs.facade_type->type_name){
+          return lhs.facade_type->type_name < rhs.facade_type->type_name;
+        }
+        return lhs.proxiable_type->type_name < rhs.proxiable_type->type_name;
+      });
+      return result;
+    }
+
+    static constexpr std::string_view ptr_type_name(ptr_type type) noexcept{
+      switch(type){
+        case inplace: return "inplace";
+        case allocated: return "allocated";
+        case compact: return "compact";
+        default: return "raw";
+      }
+    }
+
+    // Prints the statistics followed by one line per (facade, type) key and
+    // its registered storage kinds.
+    static void dump(std::ostream& os = std::cout){
+      registry_stats s = stats();
+      os << "registry: " << s.key_count << " keys, " << s.entry_count << " entries, "
+          << s.bucket_count << " buckets (load " << s.load_factor << "), probe max "
+          << s.max_probe_length << " mean " << s.mean_probe_length << ", ~"
+          << s.total_bytes << " bytes\n";
+      std::shared_lock<std::shared_mutex> lock{meta_map_mutex};
+      for(auto& k : s.keys){
+        os << "  " << k.facade_type->type_name << " <- " << k.proxiable_type->type_name;
+        if(k.lookups != 0u){
+          os << " [" << k.lookups << " lookups]";
+        }
+        os << ":";
+        if(auto iter = meta_map().find(meta_key{k.facade_type, k.proxiable_type}); iter != meta_map().end()){
+          for(auto& info : iter->second){
+            os << " " << ptr_type_name(info.type);
+            if(info.type == allocated || info.type == compact){
+              os << "(" << info.allocator->type_name << ")";
+            }
+          }
+        }else{
+          os << " unregistered";
+        }
+        os << "\n";
+      }
+    }
+
+#if PRO_PERF_MAP
+    // The dispatchers of every registered (facade, pointer type), by
+    // address. Pointer types sharing a dispatcher are folded into the first
+    // name, e.g. "Shape::MemArea<Square> int () const (+2)".
+    static std::vector<dispatcher_symbol> dispatcher_symbols(){
+      std::vector<dispatcher_symbol> all;
+      {
+        std::shared_lock<std::shared_mutex> lock{meta_map_mutex};
+        for(auto collect : symbol_sources()){
+          collect(all);
+        }
+      }
+      std::stable_sort(all.begin(), all.end(), [](const dispatcher_symbol& lhs, const dispatcher_symbol& rhs){
+        return std::less<const void*>{}(lhs.address, rhs.address);
+      });
+      std::vector<dispatcher_symbol> result;
+      for(std::size_t i = 0u; i < all.size();){
+        std::size_t j = i + 1u;
+        while(j < all.size() && all[j].address == all[i].address){
+          ++j;
+        }
+        result.push_back(std::move(all[i]));
+        if(j - i > 1u){
+          result.back().name += " (+" + std::to_string(j - i - 1u) + ")";
+        }
+        i = j;
       }
-    };
+      return result;
+    }
 
-    inline static std::unordered_map<meta_key, std::vector<meta_info>, type_token_hasher> meta_map{};
+    // Writes the symbols as lines of "<start> <size> <name>", start and size
+    // in hex, which is the format of the perf map of a process. The sizes of
+    // functions are unknown, so each symbol extends to the next dispatcher,
+    // up to max_size bytes.
+    static void write_perf_map(std::ostream& os, std::size_t max_size = 256u){
+      std::vector<dispatcher_symbol> symbols = dispatcher_symbols();
+      auto flags = os.flags();
+      os << std::hex;
+      for(std::size_t i = 0u; i < symbols.size(); ++i){
+        auto start = reinterpret_cast<std::uintptr_t>(symbols[i].address);
+        std::size_t size = max_size;
+        if(i + 1u < symbols.size()){
+          size = std::min(size, static_cast<std::size_t>(
+              reinterpret_cast<std::uintptr_t>(symbols[i + 1u].address) - start));
+        }
+        os << start << " " << size << " " << symbols[i].name << "\n";
+      }
+      os.flags(flags);
+    }
+    // Writes /tmp/perf-<pid>.map, or path if given. perf reads that file
+    // only for code outside the mapped binaries; for dispatchers in them it
+    // serves as a side-car symbol file. Returns false if it cannot be written.
+    static bool write_perf_map(const char* path = nullptr, std::size_t max_size = 256u){
+      std::string default_path;
+      if(path == nullptr){
+        default_path = "/tmp/perf-" + std::to_string(___PRO_GETPID()) + ".map";
+        path = default_path.c_str();
+      }
+      std::ofstream file{path};
+      write_perf_map(file, max_size);
+      return static_cast<bool>(file.flush());
+    }
+#endif  // PRO_PERF_MAP
 
-    template<class P, class F> inline static bool registered = false;
+    template<class P, class F> inline static std::atomic<bool> registered{false};
     template<class P, class F>
     static void register_facade_meta(){
-      if(registered<P, F>) return;
-      registered<P, F> = true;
+      if(registered<P, F>.load(std::memory_order_acquire)) return;
+      std::lock_guard<std::shared_mutex> lock{meta_map_mutex};
+      if(registered<P, F>.load(std::memory_order_relaxed)) return;
 
-      auto meta_ = meta_ptr<typename facade_traits<F>::meta>{std::in_place_type<P>};
+      auto meta_ = typename facade_traits<F>::meta_ptr_type{std::in_place_type<P>};
       auto key = meta_key{std::in_place_type<F>, std::in_place_type<typename get_object_fn_collections<P>::value_type>};
       auto value = meta_info((std::byte*)meta_.get_ptr(), std::in_place_type<P>, static_type_token{std::in_place_type<typename get_object_fn_collections<P>::allocator>});
 
-      decltype(meta_map)::iterator iter;
+      auto& map = meta_map();
+      meta_map_type::iterator iter;
 
-      if((iter = meta_map.find(key)) == meta_map.end()){
-        meta_map[key] = std::vector<meta_info>{value};
+      if((iter = map.find(key)) == map.end()){
+        map[key] = std::vector<meta_info>{value};
       }else{
         (*iter).second.push_back(value);
       }
-
+#if PRO_PERF_MAP
+      symbol_sources().push_back(&collect_symbols<P, F>);
+#endif  // PRO_PERF_MAP
+      registered<P, F>.store(true, std::memory_order_release);
     }
     template<class T, class F>
     static void register_facade_inplace(){
@@ -1073,6 +2564,15 @@ namespace details{
     }
   };
 
+  // A constant-initialized proxy cannot register itself, so its constructor
+  // names meta_registrar_v<P, F> instead; the dynamic initializer of that
+  // variable registers (P, F) before main.
+  template<class P, class F>
+  struct meta_registrar{
+    meta_registrar(){ static_meta_manager::register_facade_meta<P, F>(); }
+  };
+  template<class P, class F> inline const meta_registrar<P, F> meta_registrar_v{};
+
 
 }  // namespace details
 
@@ -1100,7 +2600,7 @@ class proxy : public details::facade_traits<F>::direct_accessor {
   using _Traits = details::facade_traits<F>;
 
  public:
-  proxy() noexcept {
+  constexpr proxy() noexcept {
     ___PRO_DEBUG(
       std::ignore = static_cast<proxy_indirect_accessor<F>*
           (proxy::*)() noexcept>(&proxy::operator->);
@@ -1116,7 +2616,7 @@ class proxy : public details::facade_traits<F>::direct_accessor {
           (proxy::*)() const&& noexcept>(&proxy::operator*);
     )
   }
-  proxy(std::nullptr_t) noexcept : proxy() {}
+  constexpr proxy(std::nullptr_t) noexcept : proxy() {}
   proxy(const proxy& rhs)
       noexcept(F::constraints::copyability == constraint_level::nothrow) {
     static_assert(F::constraints::copyability > constraint_level::none, "Copy not supported for facade F");
@@ -1152,22 +2652,26 @@ class proxy : public details::facade_traits<F>::direct_accessor {
   }
 
   template <class P>
-  proxy(P&& ptr, 
+  constexpr proxy(P&& ptr, 
     typename std::enable_if<!std::is_same_v<P, std::nullptr_t>, int>::type = 0, 
     typename std::enable_if<!details::is_in_place_type<std::decay_t<P>>, int>::type = 0,
+    typename std::enable_if<!std::is_same_v<std::decay_t<P>, proxy>, int>::type = 0,
     typename std::enable_if<proxiable<std::decay_t<P>, F>, int>::type = 0,
     typename std::enable_if<std::is_constructible_v<std::decay_t<P>, P>, int>::type = 0) 
     noexcept(std::is_nothrow_constructible_v<std::decay_t<P>, P>)
-      : proxy() { 
-        initialize<std::decay_t<P>>(std::forward<P>(ptr)); }
+      : proxy(std::in_place_type<std::decay_t<P>>,
+          std::conditional_t<details::is_inplace_ptr<std::decay_t<P>>,
+              details::generic_storage_init,
+              details::storage_init_t<std::decay_t<P>, F>>{},
+          std::forward<P>(ptr)) {}
         
   template <typename P, class... Args>
-  explicit proxy(std::in_place_type_t<P>, Args&&... args)
+  constexpr explicit proxy(std::in_place_type_t<P>, Args&&... args)
       noexcept(std::is_nothrow_constructible_v<P, Args...>)
-      : proxy() { 
+      : proxy(std::in_place_type<P>, details::storage_init_t<P, F>{},
+          std::forward<Args>(args)...) { 
         static_assert(std::is_constructible_v<P, Args...>, "P should be able to construct with given arguments");
         static_assert(proxiable<P, F>, "P should proxiable as type F");
-        initialize<P>(std::forward<Args>(args)...); 
       }
   template <typename P, class U, class... Args>
   explicit proxy(std::in_place_type_t<P>, std::initializer_list<U> il,
@@ -1239,7 +2743,7 @@ class proxy : public details::facade_traits<F>::direct_accessor {
     }
     return *this;
   }
-  ~proxy() noexcept(F::constraints::destructibility == constraint_level::nothrow)
+  ___PRO_CONSTEXPR_DTOR ~proxy() noexcept(F::constraints::destructibility == constraint_level::nothrow)
           {
       if constexpr(F::constraints::destructibility == constraint_level::nontrivial ||
           F::constraints::destructibility == constraint_level::nothrow){
@@ -1330,15 +2834,57 @@ class proxy : public details::facade_traits<F>::direct_accessor {
         reinterpret_cast<P*>(ptr_), std::forward<Args>(args)...);
     if constexpr (std::is_convertible_v<P, bool>)
         { assert((bool)result); }
-    meta_ = details::meta_ptr<typename _Traits::meta>{std::in_place_type<P>};
+    meta_ = typename _Traits::meta_ptr_type{std::in_place_type<P>};
     details::static_meta_manager::register_facade_meta<P, F>();
     return result;
   }
 
+ private:
+  template <class P, class... Args>
+  constexpr proxy(std::in_place_type_t<P>, details::generic_storage_init,
+      Args&&... args) : proxy() { initialize<P>(std::forward<Args>(args)...); }
+  // The two constructors below only write union members, so that a proxy
+  // with static storage duration is constant-initialized; (F, P) is then
+  // registered by details::meta_registrar_v at startup.
+  template <class P, class... Args>
+  constexpr proxy(std::in_place_type_t<P>, details::raw_storage_init,
+      Args&&... args) noexcept
+      : meta_(std::in_place_type<P>),
+        raw_(details::erase_object_ptr(P{std::forward<Args>(args)...})) {
+    assert(raw_ != nullptr);
+    register_meta<P>();
+  }
+#ifdef ___PRO_BIT_CAST
+  template <class P, class... Args>
+  constexpr proxy(std::in_place_type_t<P>, details::image_storage_init,
+      Args&&... args)
+      noexcept(std::is_nothrow_constructible_v<P, Args...>)
+      : meta_(std::in_place_type<P>),
+        image_(details::make_storage_image<F::constraints::max_size,
+            typename P::type>(std::forward<Args>(args)...)) {
+    register_meta<P>();
+  }
+#endif  // ___PRO_BIT_CAST
+  template <class P>
+  constexpr void register_meta() {
+    if (___PRO_IS_CONSTANT_EVALUATED()) {
+      static_cast<void>(&details::meta_registrar_v<P, F>);
+    } else {
+      details::static_meta_manager::register_facade_meta<P, F>();
+    }
+  }
+
+ public:
   [[___PRO_NO_UNIQUE_ADDRESS_ATTRIBUTE]]
   proxy_indirect_accessor<F> ia_;
-  details::meta_ptr<typename _Traits::meta> meta_;
-  alignas(F::constraints::max_align) std::byte ptr_[F::constraints::max_size];
+  typename _Traits::meta_ptr_type meta_;
+  union {
+    details::empty_storage empty_ = {};
+    alignas(F::constraints::max_align) std::byte ptr_[F::constraints::max_size];
+    std::conditional_t<details::has_raw_storage<F::constraints::max_size,
+        F::constraints::max_align>, void*, details::empty_storage> raw_;
+    details::storage_image<F::constraints::max_size> image_;
+  };
 };
 
 template <bool IsDirect, class D, class O, class F, class... Args>
@@ -1368,6 +2914,150 @@ auto proxy_invoke(const proxy<F>&& p, Args&&... args)
       std::move(p), std::forward<Args>(args)...);
 }
 
+namespace details {
+
+// Checks the meta pointer against the statically known metas of
+// inplace_ptr<T> and T*, so that a hit calls a constant dispatcher the
+// compiler is able to inline.
+template <class T, bool IsDirect, class D, class O, qualifier_type Q, class F,
+    class... Args>
+decltype(auto) invoke_expect(add_qualifier_t<proxy<F>, Q> p, Args&&... args) {
+  using MP = typename overload_traits<O>::template meta_provider<IsDirect, D>;
+  assert((std::ignore = "proxy probably have been dumped" , p.has_value()));
+  if constexpr (proxiable<inplace_ptr<T>, F>) {
+    if (proxy_helper<F>::template holds<inplace_ptr<T>>(p)) {
+      constexpr auto dispatcher = MP::template get<inplace_ptr<T>>();
+      return proxy_helper<F>::template call<IsDirect, O, Q>(dispatcher,
+          std::forward<add_qualifier_t<proxy<F>, Q>>(p),
+          std::forward<Args>(args)...);
+    }
+  }
+  if constexpr (proxiable<T*, F>) {
+    if (proxy_helper<F>::template holds<T*>(p)) {
+      constexpr auto dispatcher = MP::template get<T*>();
+      return proxy_helper<F>::template call<IsDirect, O, Q>(dispatcher,
+          std::forward<add_qualifier_t<proxy<F>, Q>>(p),
+          std::forward<Args>(args)...);
+    }
+  }
+  return proxy_helper<F>::template invoke<IsDirect, D, O, Q>(
+      std::forward<add_qualifier_t<proxy<F>, Q>>(p),
+      std::forward<Args>(args)...);
+}
+
+}  // namespace details
+
+template <class T, class D, class O, bool IsDirect = false, class F,
+    class... Args>
+auto proxy_invoke_expect(proxy<F>& p, Args&&... args)
+    -> typename details::overload_traits<O>::return_type {
+  return details::invoke_expect<T, IsDirect, D, O,
+      details::qualifier_type::lv, F>(p, std::forward<Args>(args)...);
+}
+template <class T, class D, class O, bool IsDirect = false, class F,
+    class... Args>
+auto proxy_invoke_expect(const proxy<F>& p, Args&&... args)
+    -> typename details::overload_traits<O>::return_type {
+  return details::invoke_expect<T, IsDirect, D, O,
+      details::qualifier_type::const_lv, F>(p, std::forward<Args>(args)...);
+}
+template <class T, class D, class O, bool IsDirect = false, class F,
+    class... Args>
+auto proxy_invoke_expect(proxy<F>&& p, Args&&... args)
+    -> typename details::overload_traits<O>::return_type {
+  return details::invoke_expect<T, IsDirect, D, O,
+      details::qualifier_type::rv, F>(std::move(p), std::forward<Args>(args)...);
+}
+template <class T, class D, class O, bool IsDirect = false, class F,
+    class... Args>
+auto proxy_invoke_expect(const proxy<F>&& p, Args&&... args)
+    -> typename details::overload_traits<O>::return_type {
+  return details::invoke_expect<T, IsDirect, D, O,
+      details::qualifier_type::const_rv, F>(
+      std::move(p), std::forward<Args>(args)...);
+}
+
+// Tiny cache of (meta pointer -> dispatcher) for a single call site. It
+// starts monomorphic and grows up to `capacity` entries; once full, misses
+// replace entries round-robin.
+template <class D, class O, bool IsDirect = false>
+class inline_cache {
+  using meta_provider = typename details::overload_traits<O>
+      ::template meta_provider<IsDirect, D>;
+  using dispatcher_type = decltype(meta_provider::template get<void>());
+
+ public:
+  static constexpr std::size_t capacity = 4u;
+
+  template <class F, class... Args>
+  auto invoke(proxy<F>& p, Args&&... args)
+      -> typename details::overload_traits<O>::return_type {
+    return invoke_impl<details::qualifier_type::lv, F>(
+        p, std::forward<Args>(args)...);
+  }
+  template <class F, class... Args>
+  auto invoke(const proxy<F>& p, Args&&... args)
+      -> typename details::overload_traits<O>::return_type {
+    return invoke_impl<details::qualifier_type::const_lv, F>(
+        p, std::forward<Args>(args)...);
+  }
+  template <class F, class... Args>
+  auto invoke(proxy<F>&& p, Args&&... args)
+      -> typename details::overload_traits<O>::return_type {
+    return invoke_impl<details::qualifier_type::rv, F>(
+        std::move(p), std::forward<Args>(args)...);
+  }
+  template <class F, class... Args>
+  auto invoke(const proxy<F>&& p, Args&&... args)
+      -> typename details::overload_traits<O>::return_type {
+    return invoke_impl<details::qualifier_type::const_rv, F>(
+        std::move(p), std::forward<Args>(args)...);
+  }
+
+  std::size_t size() const noexcept { return size_; }
+  std::uint64_t hits() const noexcept { return hits_; }
+  std::uint64_t misses() const noexcept { return misses_; }
+  void reset() noexcept { size_ = 0u; next_ = 0u; hits_ = 0u; misses_ = 0u; }
+
+ private:
+  template <details::qualifier_type Q, class F, class... Args>
+  decltype(auto) invoke_impl(details::add_qualifier_t<proxy<F>, Q> p,
+      Args&&... args) {
+    using helper = details::proxy_helper<F>;
+    const void* key = helper::meta_identity(p);
+    dispatcher_type dispatcher = lookup(key);
+    if (dispatcher == nullptr) {
+      ++misses_;
+      dispatcher = helper::template get_dispatcher<meta_provider>(p);
+      if (key != nullptr) { insert(key, dispatcher); }
+    } else {
+      ++hits_;
+    }
+    return helper::template call<IsDirect, O, Q>(dispatcher,
+        std::forward<details::add_qualifier_t<proxy<F>, Q>>(p),
+        std::forward<Args>(args)...);
+  }
+  dispatcher_type lookup(const void* key) const noexcept {
+    if (size_ != 0u && keys_[0] == key) { return values_[0]; }
+    for (std::size_t i = 1u; i < size_; ++i) {
+      if (keys_[i] == key) { return values_[i]; }
+    }
+    return nullptr;
+  }
+  void insert(const void* key, dispatcher_type dispatcher) noexcept {
+    std::size_t i = size_ < capacity ? size_++ : next_++ % capacity;
+    keys_[i] = key;
+    values_[i] = dispatcher;
+  }
+
+  const void* keys_[capacity] = {};
+  dispatcher_type values_[capacity] = {};
+  std::size_t size_ = 0u;
+  std::size_t next_ = 0u;
+  std::uint64_t hits_ = 0u;
+  std::uint64_t misses_ = 0u;
+};
+
 template <bool IsDirect, class R, class F>
 const R& proxy_reflect(const proxy<F>& p) noexcept {
   return static_cast<const details::refl_meta<IsDirect, R>&>(
@@ -1425,6 +3115,8 @@ class inplace_ptr {
       { return std::forward<const T>(value_); }
 
  private:
+  // The only member, at the address of the pointer itself, which lets
+  // object_conv_dispatcher be used for it directly.
   T value_;
 };
 
@@ -1631,7 +3323,7 @@ struct get_object_fn_collections<P *>{
   using value_type = P *;
   using allocator = void;
   static std::byte* get_ptr(std::byte* ptrs){
-    return (std::byte*)(*(P **)ptrs);
+    return (std::byte*)load_object_ptr<P*>(*ptrs);
   }
   static constexpr void (*get_copy_fn())(std::byte *dst, std::byte* obj, const std::byte *alloc){
     return &create_ptr_copy;
@@ -1640,7 +3332,7 @@ struct get_object_fn_collections<P *>{
     return nullptr;
   }
   static void create_ptr_copy(std::byte *dst, std::byte* obj, [[maybe_unused]] const std::byte *alloc){
-    *(P**)dst = *(P**)obj;
+    std::construct_at((P**)dst, load_object_ptr<P*>(*obj));
   }
   static auto create_ptr_move([[maybe_unused]]std::byte *dst, [[maybe_unused]]std::byte* obj, [[maybe_unused]] const std::byte *alloc){
     
@@ -1676,6 +3368,120 @@ struct get_object_fn_collections{
   static constexpr static_meta_manager::ptr_type type = static_meta_manager::ptr_type::raw;
 };
 
+template <class T> struct inplace_registration {};
+template <class T, class Alloc> struct allocated_registration {};
+template <class T> struct pointer_registration {};
+
+// Pointer type a registration resolves to, chosen the same way as
+// register_facade_inplace / register_facade_allocated do.
+template <class F, class R> struct registration_ptr;
+template <class F, class T>
+struct registration_ptr<F, inplace_registration<T>> {
+  static_assert(proxiable<inplace_ptr<T>, F>,
+      "Cannot find compatible inplace storage type for type T");
+  using type = inplace_ptr<T>;
+};
+template <class F, class T, class Alloc>
+struct registration_ptr<F, allocated_registration<T, Alloc>> {
+  static_assert(proxiable<allocated_ptr<T, Alloc>, F> ||
+      proxiable<compact_ptr<T, Alloc>, F>,
+      "Cannot find compatible storage type for type T");
+  using type = std::conditional_t<proxiable<allocated_ptr<T, Alloc>, F>,
+      allocated_ptr<T, Alloc>, compact_ptr<T, Alloc>>;
+};
+template <class F, class T>
+struct registration_ptr<F, pointer_registration<T>> {
+  static_assert(proxiable<T*, F>, "T* is not proxiable as F");
+  using type = T*;
+};
+
+// Compile-time counterpart of static_meta_manager::meta_info. It keeps the
+// meta pointer itself rather than its address, so every field is a constant
+// expression.
+template <class MP>
+struct precomputed_meta_info {
+  template <class P>
+  constexpr explicit precomputed_meta_info(std::in_place_type_t<P>) noexcept
+      : hash(static_type_token{std::in_place_type<
+            typename get_object_fn_collections<P>::value_type>}->hash),
+        proxiable_type(std::in_place_type<
+            typename get_object_fn_collections<P>::value_type>),
+        allocator(std::in_place_type<
+            typename get_object_fn_collections<P>::allocator>),
+        type(get_object_fn_collections<P>::type),
+        meta(std::in_place_type<P>),
+        create_ptr_copy(get_object_fn_collections<P>::get_copy_fn()),
+        create_ptr_move(get_object_fn_collections<P>::get_move_fn()) {}
+
+  std::uint64_t hash;
+  static_type_token proxiable_type;
+  static_type_token allocator;
+  static_meta_manager::ptr_type type;
+  MP meta;
+  void (*create_ptr_copy)(std::byte *dst, std::byte* obj, const std::byte *alloc);
+  void (*create_ptr_move)(std::byte *dst, std::byte* obj, const std::byte *alloc);
+};
+
+// Registrations of facade F sorted by the hash of the proxiable type. The
+// table is constant-initialized, so it needs neither the heap nor a first
+// construction of proxy<F> before it can be used.
+template <class F, class... Rs>
+struct precomputed_registry {
+  using entry_type =
+      precomputed_meta_info<typename facade_traits<F>::meta_ptr_type>;
+
+  static constexpr bool enabled = true;
+  static constexpr std::array<entry_type, sizeof...(Rs)> table = [] {
+    std::array<entry_type, sizeof...(Rs)> result{entry_type{std::in_place_type<
+        typename registration_ptr<F, Rs>::type>}...};
+    for (std::size_t i = 1u; i < result.size(); ++i) {
+      for (std::size_t j = i; j > 0u && result[j].hash < result[j - 1u].hash;
+          --j) {
+        entry_type tmp = result[j];
+        result[j] = result[j - 1u];
+        result[j - 1u] = tmp;
+      }
+    }
+    return result;
+  }();
+
+  // Entries whose proxiable type hashes like t; callers still compare the
+  // tokens to rule out collisions.
+  static std::pair<const entry_type*, const entry_type*> equal_range(
+      const static_type_token& t) noexcept { return equal_range(t->hash); }
+  static std::pair<const entry_type*, const entry_type*> equal_range(
+      std::uint64_t hash) noexcept {
+    const entry_type* first = table.data();
+    std::size_t count = table.size();
+    while (count > 0u) {
+      std::size_t half = count / 2u;
+      if (first[half].hash < hash) {
+        first += half + 1u;
+        count -= half + 1u;
+      } else {
+        count = half;
+      }
+    }
+    const entry_type* last = first;
+    while (last != table.data() + table.size() && last->hash == hash)
+        { ++last; }
+    return {first, last};
+  }
+};
+
+template <class F, class Rs> struct registrations_registry;
+template <class F, class... Rs>
+struct registrations_registry<F, std::tuple<Rs...>>
+    : std::type_identity<precomputed_registry<F, Rs...>> {};
+
+// The registrations are a member of F, declared by PRO_PRECOMPUTED_REGISTRY
+// in its definition, so every translation unit sees the same registry.
+template <class F, class = void>
+struct facade_registry { static constexpr bool enabled = false; };
+template <class F>
+struct facade_registry<F, std::void_t<typename F::precomputed_registrations>>
+    : registrations_registry<F, typename F::precomputed_registrations>::type {};
+
 struct poly_cast_meta{
   constexpr poly_cast_meta() noexcept :proxiable_type(), addr_fn(nullptr) {}
   using get_object_addr_fn = std::byte *(std::byte *);
@@ -1701,69 +3507,76 @@ struct poly_cast_meta{
 
   template<class NF, class F, class Alloc = std::nullptr_t>
   std::optional<pro::proxy<NF>> cast_copy([[maybe_unused]]pro::proxy<F>& proxy, [[maybe_unused]]std::optional<Alloc> allocator = std::optional<Alloc>()) const noexcept{
-    pro::proxy<NF> new_proxy{};
-
-    auto key = static_meta_manager::meta_key(static_type_token{std::in_place_type<NF>}, proxiable_type);
-
-    auto& meta_table = static_meta_manager::meta_map;
-    decltype(static_meta_manager::meta_map)::iterator iter;
-    if((iter = meta_table.find(key)) == meta_table.end()){
-      return std::optional<pro::proxy<NF>>();
-    }
-  
-    auto& info = (*iter).second;
-
-    auto obj_addr = addr_fn(proxy.ptr_);
-
-    static_type_token allocator_token{std::in_place_type<Alloc>};
-
-    for(auto& i:info){
-      if(i.type == static_meta_manager::ptr_type::inplace || i.allocator == allocator_token){
-        if(i.create_ptr_copy != nullptr){
-          i.create_ptr_copy(new_proxy.ptr_, obj_addr, (const std::byte*)&allocator.value());
-
-          new_proxy.meta_ = pro::details::meta_ptr<typename facade_traits<NF>::meta>(i.meta_ptr);
-          return std::optional<pro::proxy<NF>>(std::move(new_proxy));
-        }
-      }
-    }
-    return std::optional<pro::proxy<NF>>();
+    return cast_impl<NF, false>(proxy, allocator);
   }
 
   template<class NF, class F, class Alloc = std::nullptr_t>
   std::optional<pro::proxy<NF>> cast_move([[maybe_unused]]pro::proxy<F>& proxy, [[maybe_unused]] const std::optional<Alloc>& allocator = std::optional<Alloc>()) const noexcept{
-    pro::proxy<NF> new_proxy{};
-
-    auto key = static_meta_manager::meta_key(static_type_token{std::in_place_type<NF>}, proxiable_type);
-
-    auto& meta_table = static_meta_manager::meta_map;
-    decltype(static_meta_manager::meta_map)::iterator iter;
-    if((iter = meta_table.find(key)) == meta_table.end()){
-      return std::optional<pro::proxy<NF>>();
-    }
-  
-    auto& info = (*iter).second;
+    return cast_impl<NF, true>(proxy, allocator);
+  }
 
+ private:
+  // Looks for a registration of (NF, proxiable_type) usable with Alloc: in
+  // the precomputed table of NF first, then in the runtime registry.
+  template<class NF, bool Move, class F, class Alloc>
+  std::optional<pro::proxy<NF>> cast_impl(pro::proxy<F>& proxy, const std::optional<Alloc>& allocator) const noexcept{
+    pro::proxy<NF> new_proxy{};
     auto obj_addr = addr_fn(proxy.ptr_);
-
+    auto alloc_addr = allocator.has_value() ? (const std::byte*)&*allocator : nullptr;
     static_type_token allocator_token{std::in_place_type<Alloc>};
 
-    for(auto& i:info){
-      if(i.type == static_meta_manager::ptr_type::inplace || i.allocator == allocator_token){
-        if(i.create_ptr_move == nullptr){
-          i.create_ptr_move(new_proxy.ptr_, obj_addr, (const std::byte*)&allocator.value());
+    auto usable = [&](const auto& i){
+      return (Move ? i.create_ptr_move : i.create_ptr_copy) != nullptr &&
+          (i.type == static_meta_manager::ptr_type::inplace || i.allocator == allocator_token);
+    };
+    auto create = [&](const auto& i, const auto& meta){
+      (Move ? i.create_ptr_move : i.create_ptr_copy)(new_proxy.ptr_, obj_addr, alloc_addr);
+      new_proxy.meta_ = typename facade_traits<NF>::meta_ptr_type(meta);
+      if constexpr(Move){
+        proxy.reset();
+      }
+      return std::optional<pro::proxy<NF>>(std::move(new_proxy));
+    };
 
-          new_proxy.meta_ = pro::details::meta_ptr<typename facade_traits<NF>::meta>(i.meta_ptr);
+    auto key = static_meta_manager::meta_key(static_type_token{std::in_place_type<NF>}, proxiable_type);
+#ifdef PRO_REGISTRY_STATISTICS
+    {
+      std::lock_guard<std::shared_mutex> lock{static_meta_manager::meta_map_mutex};
+      ++static_meta_manager::lookup_counts[key];
+    }
+#endif  // PRO_REGISTRY_STATISTICS
 
-          proxy.reset();
+    if constexpr(facade_registry<NF>::enabled){
+      auto [first, last] = facade_registry<NF>::equal_range(proxiable_type);
+      for(; first != last; ++first){
+        if(first->proxiable_type == proxiable_type && usable(*first)){
+          return create(*first, first->meta);
+        }
+      }
+    }
 
-          return std::optional<pro::proxy<NF>>(std::move(new_proxy));
+    // Only the lookup holds the lock: creating the object and resetting the
+    // source run user code, which may register proxies of its own.
+    std::optional<static_meta_manager::meta_info> found;
+    {
+      std::shared_lock<std::shared_mutex> lock{static_meta_manager::meta_map_mutex};
+      auto& meta_table = static_meta_manager::meta_map();
+      if(auto iter = meta_table.find(key); iter != meta_table.end()){
+        for(auto& i : iter->second){
+          if(usable(i)){
+            found = i;
+            break;
+          }
         }
       }
     }
-    return std::optional<pro::proxy<NF>>();
+    if(!found.has_value()){
+      return std::optional<pro::proxy<NF>>();
+    }
+    return create(*found, found->meta_ptr);
   }
 
+ public:
   const static_type_token proxiable_type;
   get_object_addr_fn *addr_fn;
 };
@@ -1772,11 +3585,20 @@ struct poly_cast_meta{
 
 }  // namespace details
 
+// Registrations listed in PRO_PRECOMPUTED_REGISTRY, the compile-time forms of
+// static_meta_manager::register_facade_inplace / register_facade_allocated.
+template <class T>
+using register_inplace = details::inplace_registration<T>;
+template <class T, class Alloc = std::allocator<T>>
+using register_allocated = details::allocated_registration<T, Alloc>;
+template <class T>
+using register_pointer = details::pointer_registration<T>;
+
 template <class T, class F>
 inline constexpr bool inplace_proxiable_target = proxiable<details::inplace_ptr<T>, F>;
 
 template <typename F, typename T, class... Args>
-proxy<F> make_proxy_inplace(Args&&... args)
+constexpr proxy<F> make_proxy_inplace(Args&&... args)
     noexcept(std::is_nothrow_constructible_v<T, Args...>) {
   static_assert(facade<F>, "F should be a valid facade");
   static_assert(inplace_proxiable_target<T, F>, "T should be inplace proxiable as type F");
@@ -1784,7 +3606,7 @@ proxy<F> make_proxy_inplace(Args&&... args)
       std::forward<Args>(args)...};
 }
 template <typename F, typename T, class U, class... Args>
-proxy<F> make_proxy_inplace(std::initializer_list<U> il, Args&&... args)
+constexpr proxy<F> make_proxy_inplace(std::initializer_list<U> il, Args&&... args)
     noexcept(std::is_nothrow_constructible_v<
         T, std::initializer_list<U>&, Args...>) {
   static_assert(facade<F>, "F should be a valid facade");
@@ -1793,7 +3615,7 @@ proxy<F> make_proxy_inplace(std::initializer_list<U> il, Args&&... args)
       il, std::forward<Args>(args)...};
 }
 template <typename F, class T>
-proxy<F> make_proxy_inplace(T&& value)
+constexpr proxy<F> make_proxy_inplace(T&& value)
     noexcept(std::is_nothrow_constructible_v<std::decay_t<T>, T>) {
   static_assert(facade<F>, "F should be a valid facade");
   static_assert(inplace_proxiable_target<std::decay_t<T>, F>, "T should match form of F");
@@ -1848,6 +3670,25 @@ proxy<F> make_proxy(T&& value) {
     static_assert(facade<F>, "F should be a valid facade");
   return details::make_proxy_impl<F, std::decay_t<T>>(std::forward<T>(value));
 }
+
+// Out-of-line construction of proxy<F> from a T. Its member is declared here
+// and defined below the class, so PRO_EXTERN_FACADE can suppress its implicit
+// instantiation: the metadata and dispatchers for (F, T) are then emitted
+// only by the translation unit holding PRO_INSTANTIATE_FACADE. A T that is a
+// pointer proxiable by F is stored as is, any other T through make_proxy.
+template <class F, class T>
+struct facade_instance {
+  static proxy<F> make(T value);
+};
+template <class F, class T>
+proxy<F> facade_instance<F, T>::make(T value) {
+  static_assert(facade<F>, "F should be a valid facade");
+  if constexpr (proxiable<T, F>) {
+    return proxy<F>{std::move(value)};
+  } else {
+    return details::make_proxy_impl<F, T>(std::move(value));
+  }
+}
 #endif  // __STDC_HOSTED__
 
 template <class F>
@@ -1883,21 +3724,15 @@ struct va_template_first<Head, Os...>{
     struct accessor_multi \
         : accessor_single<__F, __IsDirect, __D, __Os>... \
         { using accessor_single<__F, __IsDirect, __D, __Os>::__VA_ARGS__...; }; \
-    __MACRO(, ::pro::access_proxy<__F>(*this), __VA_ARGS__); \
-    __MACRO(noexcept, ::pro::access_proxy<__F>(*this), __VA_ARGS__); \
-    __MACRO(&, ::pro::access_proxy<__F>(*this), __VA_ARGS__); \
-    __MACRO(& noexcept, ::pro::access_proxy<__F>(*this), __VA_ARGS__); \
-    __MACRO(&&, ::pro::access_proxy<__F>(::std::forward<accessor_single>(*this)), \
-        __VA_ARGS__); \
-    __MACRO(&& noexcept, ::pro::access_proxy<__F>( \
+    __MACRO(noexcept(__NX), ::pro::access_proxy<__F>(*this), __VA_ARGS__); \
+    __MACRO(& noexcept(__NX), ::pro::access_proxy<__F>(*this), __VA_ARGS__); \
+    __MACRO(&& noexcept(__NX), ::pro::access_proxy<__F>( \
         ::std::forward<accessor_single>(*this)), __VA_ARGS__); \
-    __MACRO(const, ::pro::access_proxy<__F>(*this), __VA_ARGS__); \
-    __MACRO(const noexcept, ::pro::access_proxy<__F>(*this), __VA_ARGS__); \
-    __MACRO(const&, ::pro::access_proxy<__F>(*this), __VA_ARGS__); \
-    __MACRO(const& noexcept, ::pro::access_proxy<__F>(*this), __VA_ARGS__); \
-    __MACRO(const&&, ::pro::access_proxy<__F>( \
-        ::std::forward<const accessor_single>(*this)), __VA_ARGS__); \
-    __MACRO(const&& noexcept, ::pro::access_proxy<__F>( \
+    __MACRO(const noexcept(__NX), ::pro::access_proxy<__F>(*this), \
+        __VA_ARGS__); \
+    __MACRO(const& noexcept(__NX), ::pro::access_proxy<__F>(*this), \
+        __VA_ARGS__); \
+    __MACRO(const&& noexcept(__NX), ::pro::access_proxy<__F>( \
         ::std::forward<const accessor_single>(*this)), __VA_ARGS__);
 
 #define ___PRO_ADL_ARG ::pro::details::adl_accessor_arg_t<__F, __IsDirect>
@@ -1916,36 +3751,24 @@ struct va_template_first<Head, Os...>{
     template <class __F, bool __IsDirect, class __D, class... __Os> \
     struct accessor_multi \
         : accessor_single<__F, __IsDirect, __D, __Os>... {}; \
-    __MACRO(,, ___PRO_ADL_ARG& __self, ::pro::access_proxy<__F>(__self), \
-        __VA_ARGS__); \
-    __MACRO(noexcept, noexcept, ___PRO_ADL_ARG& __self, \
+    __MACRO(noexcept(__NX), noexcept(__NX), ___PRO_ADL_ARG& __self, \
         ::pro::access_proxy<__F>(__self), __VA_ARGS__); \
-    __MACRO(&,, ___PRO_ADL_ARG& __self, ::pro::access_proxy<__F>(__self), \
-        __VA_ARGS__); \
-    __MACRO(& noexcept, noexcept, ___PRO_ADL_ARG& __self, \
+    __MACRO(& noexcept(__NX), noexcept(__NX), ___PRO_ADL_ARG& __self, \
         ::pro::access_proxy<__F>(__self), __VA_ARGS__); \
-    __MACRO(&&,, ___PRO_ADL_ARG&& __self, ::pro::access_proxy<__F>( \
-        ::std::forward<decltype(__self)>(__self)), __VA_ARGS__); \
-    __MACRO(&& noexcept, noexcept, ___PRO_ADL_ARG&& __self, \
+    __MACRO(&& noexcept(__NX), noexcept(__NX), ___PRO_ADL_ARG&& __self, \
         ::pro::access_proxy<__F>(::std::forward<decltype(__self)>(__self)), \
         __VA_ARGS__); \
-    __MACRO(const,, const ___PRO_ADL_ARG& __self, \
-        ::pro::access_proxy<__F>(__self), __VA_ARGS__); \
-    __MACRO(const noexcept, noexcept, const ___PRO_ADL_ARG& __self, \
+    __MACRO(const noexcept(__NX), noexcept(__NX), const ___PRO_ADL_ARG& __self, \
         ::pro::access_proxy<__F>(__self), __VA_ARGS__); \
-    __MACRO(const&,, const ___PRO_ADL_ARG& __self, \
+    __MACRO(const& noexcept(__NX), noexcept(__NX), const ___PRO_ADL_ARG& __self, \
         ::pro::access_proxy<__F>(__self), __VA_ARGS__); \
-    __MACRO(const& noexcept, noexcept, const ___PRO_ADL_ARG& __self, \
-        ::pro::access_proxy<__F>(__self), __VA_ARGS__); \
-    __MACRO(const&&,, const ___PRO_ADL_ARG&& __self, ::pro::access_proxy<__F>( \
-        ::std::forward<decltype(__self)>(__self)), __VA_ARGS__); \
-    __MACRO(const&& noexcept, noexcept, const ___PRO_ADL_ARG&& __self, \
-        ::pro::access_proxy<__F>(::std::forward<decltype(__self)>(__self)), \
-        __VA_ARGS__);
+    __MACRO(const&& noexcept(__NX), noexcept(__NX), \
+        const ___PRO_ADL_ARG&& __self, ::pro::access_proxy<__F>( \
+            ::std::forward<decltype(__self)>(__self)), __VA_ARGS__);
 
 #define ___PRO_GEN_DEBUG_SYMBOL_FOR_MEM_ACCESSOR(...) \
     ___PRO_DEBUG( \
-        accessor_single() noexcept { ::std::ignore = &accessor_single::__VA_ARGS__; })
+        constexpr accessor_single() noexcept { ::std::ignore = &accessor_single::__VA_ARGS__; })
 
 #ifdef __cpp_rtti
 class bad_proxy_cast : public std::bad_cast {
@@ -1962,7 +3785,7 @@ using adl_accessor_arg_t =
     std::conditional_t<IsDirect, proxy<F>, proxy_indirect_accessor<F>>;
 
 #define ___PRO_DEF_CAST_ACCESSOR(Q, SELF, ...) \
-    template <class __F, bool __IsDirect, class __D, class T> \
+    template <class __F, bool __IsDirect, class __D, bool __NX, class T> \
     struct accessor_single<__F, __IsDirect, __D, T() Q> { \
       ___PRO_GEN_DEBUG_SYMBOL_FOR_MEM_ACCESSOR(operator T) \
       explicit operator T() Q { \
@@ -2019,7 +3842,8 @@ using normalize_t = proxiable_ptr_constraints_t<
   substitute_if<C::max_align, invalid_size, alignof(ptr_prototype)>,
   substitute_if<C::copyability, invalid_cl, constraint_level::none>,
   substitute_if<C::relocatability, invalid_cl, constraint_level::nothrow>,
-  substitute_if<C::destructibility, invalid_cl, constraint_level::nothrow>
+  substitute_if<C::destructibility, invalid_cl, constraint_level::nothrow>,
+  embedded_dispatchers_of<C>
 >;
 
 constexpr auto normalize(proxiable_ptr_constraints value) {
@@ -2044,7 +3868,8 @@ template<typename A, std::size_t max_size, std::size_t max_align>
 using make_restricted_layout_t = proxiable_ptr_constraints_t<
   static_min<A::max_size, max_size>,
   static_min<A::max_align, max_align>,
-  A::copyability, A::relocatability, A::destructibility
+  A::copyability, A::relocatability, A::destructibility,
+  embedded_dispatchers_of<A>
 >;
 
 constexpr auto make_restricted_layout(proxiable_ptr_constraints value,
@@ -2075,7 +3900,9 @@ using merge_constraints_t = proxiable_ptr_constraints_t<
   static_min<A::max_align, B::max_align>, 
   static_max<A::copyability, B::copyability>,
   static_max<A::relocatability, B::relocatability>,
-  static_max<A::destructibility, B::destructibility>>;
+  static_max<A::destructibility, B::destructibility>,
+  (embedded_dispatchers_of<A> > embedded_dispatchers_of<B> ?
+      embedded_dispatchers_of<A> : embedded_dispatchers_of<B>)>;
 
 constexpr auto merge_constraints(proxiable_ptr_constraints a,
     proxiable_ptr_constraints b) {
@@ -2109,6 +3936,11 @@ struct conv_impl {
   template <class F>
   using accessor = instantiated_accessor_t<D, F, IsDirect, Os...>;
 };
+// A convention whose dispatchers are laid out at the start of a cache line
+// aligned meta table. It is keyed and invoked like the conv_impl it extends.
+template <bool IsDirect, class D, class... Os>
+struct hot_conv_impl : conv_impl<IsDirect, D, Os...>
+    { static constexpr bool is_hot = true; };
 template <bool IsDirect, class R>
 struct refl_impl {
   static constexpr bool is_direct = IsDirect;
@@ -2116,25 +3948,27 @@ struct refl_impl {
   template <class F>
   using accessor = instantiated_accessor_t<R, F, IsDirect>;
 };
-template <class Cs, class Rs, typename C>
+template <class Cs, class Rs, typename C, class Ss = std::tuple<>>
 struct facade_impl {
   using convention_types = Cs;
   using reflection_types = Rs;
   using constraints = C;
+  using sealed_types = Ss;
 };
 
 template<class T, class U>
 struct is_nonexist_in_tuple;
 
 
+// Membership is a single base lookup instead of a comparison per element;
+// the elements of a tuple being reduced into are always distinct.
+template <class... Ts> struct type_set : std::type_identity<Ts>... {};
 template <class O, class I>
 struct add_tuple_reduction;
 template <class... Os, class I>
 struct add_tuple_reduction<std::tuple<Os...>, I>
-    : std::type_identity<
-      typename std::conditional< ((!std::is_same_v<I, Os>) && ...), std::tuple<Os..., I>, std::tuple<Os...>>::type
-    > {};
-
+    : std::conditional<std::is_base_of_v<std::type_identity<I>,
+          type_set<Os...>>, std::tuple<Os...>, std::tuple<Os..., I>> {};
 
 template <class T, class U>
 using add_tuple_t = typename add_tuple_reduction<T, U>::type;
@@ -2143,32 +3977,66 @@ using merge_tuple_impl_t = recursive_reduction_t<add_tuple_t, O, Is...>;
 template <class T, class U>
 using merge_tuple_t = instantiated_t<merge_tuple_impl_t, U, T>;
 
-template <bool IsDirect, class D>
+template <bool IsDirect, class D, bool IsHot>
 struct merge_conv_traits
     { template <class... Os> using type = conv_impl<IsDirect, D, Os...>; };
+template <bool IsDirect, class D>
+struct merge_conv_traits<IsDirect, D, true>
+    { template <class... Os> using type = hot_conv_impl<IsDirect, D, Os...>; };
+// The merged convention is hot if either side is.
 template <class C1, class C2>
-using merge_conv_t = instantiated_t<
-    merge_conv_traits<C1::is_direct, typename C1::dispatch_type>::template type,
+using merge_conv_t = instantiated_t<merge_conv_traits<C1::is_direct,
+        typename C1::dispatch_type, is_hot_conv<C1> || is_hot_conv<C2>>
+        ::template type,
     merge_tuple_t<typename C1::overload_types, typename C2::overload_types>>;
 
-template <class Cs1, class C2, class C> struct add_conv_reduction;
-
-template <class... Cs1, class C2, class... Cs3, class C>
-struct add_conv_reduction<std::tuple<Cs1...>, std::tuple<C2, Cs3...>, C>
-    : std::conditional<(C::is_direct == C2::is_direct && std::is_same_v<
-        typename C::dispatch_type, typename C2::dispatch_type>), 
-        std::type_identity<std::tuple<Cs1..., merge_conv_t<C2, C>, Cs3...>>,
-        add_conv_reduction<std::tuple<Cs1..., C2>, std::tuple<Cs3...>, C>>::type {};
+// Conventions are keyed by (is_direct, dispatch_type). The index of the key
+// of C in Cs is found by overload resolution against indexed bases, so
+// adding a convention costs a constant number of new instantiations instead
+// of a walk (and a speculative merge) over every convention before it.
+template <bool IsDirect, class D> struct conv_key {};
+template <std::size_t I, class K> struct indexed_conv_key {};
+template <class Is, class... Cs> struct indexed_conv_keys;
+template <std::size_t... Is, class... Cs>
+struct indexed_conv_keys<std::index_sequence<Is...>, Cs...>
+    : indexed_conv_key<Is, conv_key<Cs::is_direct,
+          typename Cs::dispatch_type>>... {};
+template <class K, std::size_t I>
+constexpr std::size_t conv_index_of(const indexed_conv_key<I, K>*) noexcept
+    { return I; }
+template <class K>
+constexpr std::size_t conv_index_of(const void*) noexcept
+    { return static_cast<std::size_t>(-1); }
+
+template <bool Merge, class C1, class C2>
+struct conv_merge_at : std::type_identity<C1> {};
+template <class C1, class C2>
+struct conv_merge_at<true, C1, C2>
+    : std::type_identity<merge_conv_t<C1, C2>> {};
 
-template <class... Cs, class C>
-struct add_conv_reduction<std::tuple<Cs...>, std::tuple<>, C>
+template <class Cs, class C, std::size_t I, class Is> struct add_conv_at;
+template <class... Cs, class C, std::size_t... Is>
+struct add_conv_at<std::tuple<Cs...>, C, static_cast<std::size_t>(-1),
+    std::index_sequence<Is...>>
     : std::type_identity<std::tuple<Cs..., merge_conv_t<
           conv_impl<C::is_direct, typename C::dispatch_type>, C>>> {};
+template <class... Cs, class C, std::size_t I, std::size_t... Is>
+struct add_conv_at<std::tuple<Cs...>, C, I, std::index_sequence<Is...>>
+    : std::type_identity<std::tuple<
+          typename conv_merge_at<Is == I, Cs, C>::type...>> {};
 
-
+template <class Cs, class C> struct add_conv_reduction;
+template <class... Cs, class C>
+struct add_conv_reduction<std::tuple<Cs...>, C>
+    : add_conv_at<std::tuple<Cs...>, C,
+          details::conv_index_of<conv_key<C::is_direct,
+              typename C::dispatch_type>>(
+              static_cast<indexed_conv_keys<std::index_sequence_for<Cs...>,
+                  Cs...>*>(nullptr)),
+          std::index_sequence_for<Cs...>> {};
 
 template <class Cs, class C>
-using add_conv_t = typename add_conv_reduction<std::tuple<>, Cs, C>::type;
+using add_conv_t = typename add_conv_reduction<Cs, C>::type;
 
 template <class F, constraint_level CL>
 using copy_conversion_overload =
@@ -2370,6 +4238,117 @@ struct format_dispatch {
 };
 #endif  // __STDC_HOSTED__*/
 
+// Output of the C++17 formatting convention: a caller-provided character
+// buffer, drained through flush whenever it fills up. Without a flush
+// function, output past the end is counted but dropped.
+class format_sink {
+ public:
+  using flush_fn = void(void* context, const char* data, std::size_t size);
+
+  format_sink(char* first, char* last) noexcept
+      : format_sink(first, last, nullptr, nullptr) {}
+  format_sink(char* first, char* last, flush_fn* flush, void* context) noexcept
+      : first_(first), cur_(first), last_(last), flush_(flush),
+        context_(context), flushed_(0u), dropped_(0u) {}
+  format_sink(const format_sink&) = delete;
+
+  void append(const char* data, std::size_t size) {
+    for (;;) {
+      std::size_t n = std::min(size, static_cast<std::size_t>(last_ - cur_));
+      if (n != 0u) { std::memcpy(cur_, data, n); }
+      cur_ += n;
+      if (n == size) { return; }
+      data += n;
+      size -= n;
+      if (flush_ == nullptr || cur_ == first_) {
+        dropped_ += size;
+        return;
+      }
+      flush();
+    }
+  }
+  void append(std::string_view s) { append(s.data(), s.size()); }
+  void push_back(char c) { append(&c, 1u); }
+  void flush() {
+    if (flush_ != nullptr && cur_ != first_) {
+      flush_(context_, first_, static_cast<std::size_t>(cur_ - first_));
+      flushed_ += static_cast<std::size_t>(cur_ - first_);
+      cur_ = first_;
+    }
+  }
+
+  // Characters written so far, including flushed and dropped ones.
+  std::size_t size() const noexcept
+      { return flushed_ + static_cast<std::size_t>(cur_ - first_) + dropped_; }
+  bool truncated() const noexcept { return dropped_ != 0u; }
+  char* position() const noexcept { return cur_; }
+  // Room left in the buffer; formatters may write up to that much at
+  // position() and then commit() the new end.
+  std::size_t available() const noexcept
+      { return static_cast<std::size_t>(last_ - cur_); }
+  void commit(char* end) noexcept { cur_ = end; }
+
+ private:
+  char* first_;
+  char* cur_;
+  char* last_;
+  flush_fn* flush_;
+  void* context_;
+  std::size_t flushed_;
+  std::size_t dropped_;
+};
+
+template <class T, class = void>
+struct has_member_format_to : std::false_type {};
+template <class T>
+struct has_member_format_to<T, std::void_t<decltype(std::declval<const T&>()
+    .format_to(std::declval<format_sink&>()))>> : std::true_type {};
+template <class T>
+constexpr bool is_sink_formattable = has_member_format_to<T>::value ||
+    std::is_arithmetic_v<T> || std::is_convertible_v<const T&, std::string_view>;
+
+// Types opt in with a member `void format_to(pro::format_sink&) const`;
+// numbers go through std::to_chars and strings are copied as they are.
+template <class T>
+void format_value(format_sink& sink, const T& value) {
+  if constexpr (has_member_format_to<T>::value) {
+    value.format_to(sink);
+  } else if constexpr (std::is_same_v<T, bool>) {
+    sink.append(value ? std::string_view{"true"} : std::string_view{"false"});
+  } else if constexpr (std::is_same_v<T, char>) {
+    sink.push_back(value);
+  } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+    sink.append(static_cast<std::string_view>(value));
+  } else if constexpr (std::is_integral_v<T>) {
+    constexpr std::size_t max_size = 24u;
+    if (sink.available() >= max_size) {
+      sink.commit(std::to_chars(sink.position(), sink.position() + max_size,
+          value).ptr);
+    } else {
+      char buffer[max_size];
+      auto r = std::to_chars(buffer, buffer + max_size, value);
+      sink.append(buffer, static_cast<std::size_t>(r.ptr - buffer));
+    }
+  } else {
+    char buffer[64];
+#if defined(__cpp_lib_to_chars)
+    auto r = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    sink.append(buffer, static_cast<std::size_t>(r.ptr - buffer));
+#else
+    int n = std::snprintf(buffer, sizeof(buffer), "%.17Lg",
+        static_cast<long double>(value));
+    sink.append(buffer, static_cast<std::size_t>(n));
+#endif  // defined(__cpp_lib_to_chars)
+  }
+}
+
+struct format_to_dispatch {
+  template <class T>
+  auto operator()(const T& self, format_sink& sink)
+      -> std::enable_if_t<is_sink_formattable<T>> { format_value(sink, self); }
+};
+using format_to_overload = void(format_sink& sink) const;
+
 #ifdef __cpp_rtti
 struct proxy_cast_context {
   const std::type_info* type_ptr;
@@ -2454,7 +4433,7 @@ proxy_cast_ptr(const proxy_indirect_accessor<F>* proxy){
 }
 
 #define ___PRO_DEF_PROXY_CAST_ACCESSOR(Q, ...) \
-    template <class F, bool IsDirect, class D> \
+    template <class F, bool IsDirect, class D, bool __NX> \
     struct accessor_single<F, IsDirect, D, void(proxy_cast_context) Q> \
         : proxy_cast_accessor_impl<F, IsDirect, D, \
               void(proxy_cast_context) Q> {}
@@ -2496,7 +4475,7 @@ struct proxy_typeid_reflector {
       return *refl.info;
     }
 ___PRO_DEBUG(
-    accessor() noexcept { std::ignore = &accessor::_symbol_guard; }
+    constexpr accessor() noexcept { std::ignore = &accessor::_symbol_guard; }
 
    private:
     static inline const std::type_info& _symbol_guard(
@@ -2524,40 +4503,63 @@ struct wildcard {
 
 }  // namespace details
 
-template <class Cs, class Rs, typename C>
+using format_sink = details::format_sink;
+
+// Formats the object behind p, whose facade has support_format, into sink.
+// Nothing is allocated unless the sink's flush function does.
+template <class F>
+void format_to(format_sink& sink, const proxy<F>& p) {
+  proxy_invoke<false, details::format_to_dispatch,
+      details::format_to_overload>(p, sink);
+}
+// std::to_chars counterpart of format_to: on overflow, returns
+// {last, std::errc::value_too_large} like std::to_chars does.
+template <class F>
+std::to_chars_result to_chars(char* first, char* last, const proxy<F>& p) {
+  format_sink sink{first, last};
+  format_to(sink, p);
+  if (sink.truncated()) { return {last, std::errc::value_too_large}; }
+  return {sink.position(), std::errc{}};
+}
+
+template <class Cs, class Rs, typename C, class Ss = std::tuple<>>
 struct basic_facade_builder {
   template <class D, class... Os>
       
   using add_indirect_convention = typename std::enable_if<(sizeof...(Os) > 0u &&
           (details::overload_traits<Os>::applicable && ...)), basic_facade_builder<details::add_conv_t<
-      Cs, details::conv_impl<false, D, Os...>>, Rs, C>>::type;
+      Cs, details::conv_impl<false, D, Os...>>, Rs, C, Ss>>::type;
   template <class D, class... Os>
   using add_direct_convention = typename std::enable_if<(sizeof...(Os) > 0u &&
           (details::overload_traits<Os>::applicable && ...)), basic_facade_builder<details::add_conv_t<
-      Cs, details::conv_impl<true, D, Os...>>, Rs, C>>::type;
+      Cs, details::conv_impl<true, D, Os...>>, Rs, C, Ss>>::type;
 
 
   template <class D, class... Os>
   using add_convention = typename std::enable_if<(sizeof...(Os) > 0u &&
           (details::overload_traits<Os>::applicable && ...)), add_indirect_convention<D, Os...>>::type;
+  template <class D, class... Os>
+  using add_hot_convention = typename std::enable_if<(sizeof...(Os) > 0u &&
+          (details::overload_traits<Os>::applicable && ...)), basic_facade_builder<details::add_conv_t<
+      Cs, details::hot_conv_impl<false, D, Os...>>, Rs, C, Ss>>::type;
   template <class R>
   using add_indirect_reflection = basic_facade_builder<
-      Cs, details::add_tuple_t<Rs, details::refl_impl<false, R>>, C>;
+      Cs, details::add_tuple_t<Rs, details::refl_impl<false, R>>, C, Ss>;
   template <class R>
   using add_direct_reflection = basic_facade_builder<
-      Cs, details::add_tuple_t<Rs, details::refl_impl<true, R>>, C>;
+      Cs, details::add_tuple_t<Rs, details::refl_impl<true, R>>, C, Ss>;
   template <class R>
   using add_reflection = add_indirect_reflection<R>;
   template <typename F, bool WithUpwardConversion = false>
   using add_facade = basic_facade_builder<
       details::merge_facade_conv_t<Cs, F, WithUpwardConversion>,
       details::merge_tuple_t<Rs, typename F::reflection_types>,
-      details::merge_constraints_t<C, typename F::constraints>>;
+      details::merge_constraints_t<C, typename F::constraints>, Ss>;
 
   template <std::size_t PtrSize, std::size_t PtrAlign = details::max_align_of(PtrSize)>
   struct restrict_layout_helpers{
     static_assert((std::has_single_bit(PtrAlign) && PtrSize % PtrAlign == 0u), "Ptr size doesn't match alignment requirements");
-    using type = basic_facade_builder<Cs, Rs, details::make_restricted_layout_t<C, PtrSize, PtrAlign>>;
+    using type = basic_facade_builder<Cs, Rs, details::make_restricted_layout_t<C, PtrSize, PtrAlign>, Ss>;
   };
   template <std::size_t PtrSize,
       std::size_t PtrAlign = details::max_align_of(PtrSize)>
@@ -2565,16 +4567,19 @@ struct basic_facade_builder {
 
   template <constraint_level CL>
   using support_copy = basic_facade_builder<
-      Cs, Rs, typename C::template with_copyability<CL>>;
+      Cs, Rs, typename C::template with_copyability<CL>, Ss>;
   template <constraint_level CL>
   using support_relocation = basic_facade_builder<
-      Cs, Rs, typename C::template with_relocatability<CL>>;
+      Cs, Rs, typename C::template with_relocatability<CL>, Ss>;
   template <constraint_level CL>
   using support_destruction = basic_facade_builder<
-      Cs, Rs, typename C::template with_destructibility<CL>>;
-/*#if __STDC_HOSTED__
+      Cs, Rs, typename C::template with_destructibility<CL>, Ss>;
+  template <std::size_t N>
+  using embed_dispatchers = basic_facade_builder<
+      Cs, Rs, typename C::template with_embedded_dispatchers<N>, Ss>;
   using support_format = add_convention<
-      details::format_dispatch, details::format_overload_t<char>>;
+      details::format_to_dispatch, details::format_to_overload>;
+/*#if __STDC_HOSTED__
   using support_wformat = add_convention<
       details::format_dispatch, details::format_overload_t<wchar_t>>;
 #endif  // __STDC_HOSTED__*/
@@ -2585,20 +4590,22 @@ struct basic_facade_builder {
           void(details::proxy_cast_context) const&,
           void(details::proxy_cast_context) &&>>,
       details::add_tuple_t<Rs, details::refl_impl<false,
-          details::proxy_typeid_reflector>>, C>;
+          details::proxy_typeid_reflector>>, C, Ss>;
   using support_direct_rtti = basic_facade_builder<
       details::add_conv_t<Cs, details::conv_impl<true,
           details::proxy_cast_dispatch, void(details::proxy_cast_context) &,
           void(details::proxy_cast_context) const&,
           void(details::proxy_cast_context) &&>>,
       details::add_tuple_t<Rs, details::refl_impl<true,
-          details::proxy_typeid_reflector>>, C>;
+          details::proxy_typeid_reflector>>, C, Ss>;
   using support_rtti = support_indirect_rtti;
 #endif  // __cpp_rtti
   template <class F>
   using add_view = add_direct_convention<
       details::proxy_view_dispatch, details::proxy_view_overload<F>>;
-  using build = details::facade_impl<Cs, Rs, details::normalize_t<C>>;
+  template <class... Ts>
+  using seal = basic_facade_builder<Cs, Rs, C, std::tuple<Ts...>>;
+  using build = details::facade_impl<Cs, Rs, details::normalize_t<C>, Ss>;
   basic_facade_builder() = delete;
 };
 
@@ -2625,13 +4632,13 @@ template <typename Sign, bool Rhs = false>
 struct operator_dispatch;
 
 #define ___PRO_DEF_LHS_LEFT_OP_ACCESSOR(Q, SELF, ...) \
-    template <class __F, bool __IsDirect, class __D, class R> \
+    template <class __F, bool __IsDirect, class __D, bool __NX, class R> \
     struct accessor_single<__F, __IsDirect, __D, R() Q> { \
       ___PRO_GEN_DEBUG_SYMBOL_FOR_MEM_ACCESSOR(__VA_ARGS__) \
       R __VA_ARGS__() Q { return proxy_invoke<__IsDirect, __D, R() Q>(SELF); } \
     }
 #define ___PRO_DEF_LHS_ANY_OP_ACCESSOR(Q, SELF, ...) \
-    template <class __F, bool __IsDirect, class __D, class R, class... Args> \
+    template <class __F, bool __IsDirect, class __D, bool __NX, class R, class... Args> \
     struct accessor_single<__F, __IsDirect, __D, R(Args...) Q> { \
       ___PRO_GEN_DEBUG_SYMBOL_FOR_MEM_ACCESSOR(__VA_ARGS__) \
       R __VA_ARGS__(Args... args) Q { \
@@ -2670,14 +4677,14 @@ struct operator_dispatch;
     };
 
 #define ___PRO_DEF_RHS_OP_ACCESSOR(Q, NE, SELF_ARG, SELF, ...) \
-    template <class __F, bool __IsDirect, class __D, class R, class Arg> \
+    template <class __F, bool __IsDirect, class __D, bool __NX, class R, class Arg> \
     struct accessor_single<__F, __IsDirect, __D, R(Arg) Q> { \
       friend R operator __VA_ARGS__(Arg arg, SELF_ARG) NE { \
         return proxy_invoke<__IsDirect, __D, R(Arg) Q>( \
             SELF, std::forward<Arg>(arg)); \
       } \
 ___PRO_DEBUG( \
-      accessor_single() noexcept { std::ignore = &accessor_single::_symbol_guard; } \
+      constexpr accessor_single() noexcept { std::ignore = &accessor_single::_symbol_guard; } \
     \
      private: \
       static inline R _symbol_guard(Arg arg, SELF_ARG) NE { \
@@ -2706,7 +4713,7 @@ ___PRO_DEBUG( \
     ___PRO_RHS_OP_DISPATCH_IMPL(OP, __VA_ARGS__)
 
 #define ___PRO_DEF_LHS_ASSIGNMENT_OP_ACCESSOR(Q, SELF, ...) \
-    template <class __F, bool __IsDirect, class __D, class R, class Arg> \
+    template <class __F, bool __IsDirect, class __D, bool __NX, class R, class Arg> \
     struct accessor_single<__F, __IsDirect, __D, R(Arg) Q> { \
       ___PRO_GEN_DEBUG_SYMBOL_FOR_MEM_ACCESSOR(__VA_ARGS__) \
       decltype(auto) __VA_ARGS__(Arg arg) Q { \
@@ -2719,14 +4726,14 @@ ___PRO_DEBUG( \
       } \
     }
 #define ___PRO_DEF_RHS_ASSIGNMENT_OP_ACCESSOR(Q, NE, SELF_ARG, SELF, ...) \
-    template <class __F, bool __IsDirect, class __D, class R, class Arg> \
+    template <class __F, bool __IsDirect, class __D, bool __NX, class R, class Arg> \
     struct accessor_single<__F, __IsDirect, __D, R(Arg&) Q> { \
       friend Arg& operator __VA_ARGS__(Arg& arg, SELF_ARG) NE { \
         proxy_invoke<__IsDirect, __D, R(Arg&) Q>(SELF, arg); \
         return arg; \
       } \
 ___PRO_DEBUG( \
-      accessor_single() noexcept { std::ignore = &accessor_single::_symbol_guard; } \
+      constexpr accessor_single() noexcept { std::ignore = &accessor_single::_symbol_guard; } \
     \
      private: \
       static inline Arg& _symbol_guard(Arg& arg, SELF_ARG) NE \
@@ -2906,6 +4913,114 @@ struct weak_dispatch_with_handler : D {
       { (E{}); return details::wildcard(); }
 };
 
+// Double dispatch on the concrete types of two proxies. Added to a facade as
+// a direct reflection, it records the position of the pointee type in Ts
+// (sizeof...(Ts) when unlisted) in the meta table. multi_invoke() then picks
+// the implementation from a constant (N + 1) x (N + 1) table: D is invoked
+// with both objects, or with two nullptrs for pairs it does not handle, like
+// the default dispatcher of a convention. Without such a fallback
+// not_implemented is thrown. A const pointee (e.g. of a const T*) is passed as
+// const even through a non-const proxy, so overloads that would modify it
+// fall back as well.
+template <class D, class O, class... Ts>
+struct multi_dispatch;
+template <class D, class R, class... Args, class... Ts>
+struct multi_dispatch<D, R(Args...), Ts...> {
+  static constexpr std::size_t type_count = sizeof...(Ts);
+
+  template <class P>
+  constexpr explicit multi_dispatch(std::in_place_type_t<P>) noexcept
+      : index(index_of<std::remove_cv_t<details::ptr_element_t<P>>>),
+        object(&object_of<P>),
+        const_pointee(std::is_const_v<details::ptr_element_t<P>>) {}
+  constexpr multi_dispatch(const multi_dispatch&) noexcept = default;
+
+  template <bool Const, class F1, class F2, class... Ts2>
+  static R invoke(const proxy<F1>& lhs, const proxy<F2>& rhs, Ts2&&... args) {
+    assert(lhs.has_value() && rhs.has_value());
+    const multi_dispatch& l = proxy_reflect<true, multi_dispatch>(lhs);
+    const multi_dispatch& r = proxy_reflect<true, multi_dispatch>(rhs);
+    const table_type& t = *tables[Const || l.const_pointee]
+        [Const || r.const_pointee];
+    return t[l.index][r.index](
+        l.object(details::proxy_helper<F1>::storage(lhs)),
+        r.object(details::proxy_helper<F2>::storage(rhs)),
+        std::forward<Ts2>(args)...);
+  }
+
+  std::size_t index;
+  void* (*object)(std::byte&) noexcept;
+  bool const_pointee;
+
+ private:
+  template <class T>
+  static constexpr std::size_t index_of = [] {
+    std::size_t result = sizeof...(Ts), i = 0u;
+    ((result = (result == sizeof...(Ts) && std::is_same_v<T, Ts>) ? i : result,
+        ++i), ...);
+    return result;
+  }();
+  template <class P>
+  static void* object_of(std::byte& self) noexcept {
+    auto& obj = [&]() -> decltype(auto) {
+      if constexpr (details::is_object_ptr<P>) {
+        return *details::load_object_ptr<P>(self);
+      } else {
+        return **std::launder(reinterpret_cast<P*>(&self));
+      }
+    }();
+    return const_cast<void*>(static_cast<const volatile void*>(
+        std::addressof(obj)));
+  }
+
+  using entry_type = R (*)(void*, void*, Args...);
+  template <bool C1, bool C2, class T1, class T2>
+  static R entry(void* lhs, void* rhs, Args... args) {
+    using L = std::conditional_t<C1, const T1&, T1&>;
+    using Rt = std::conditional_t<C2, const T2&, T2&>;
+    if constexpr (std::is_invocable_r_v<R, D, L, Rt, Args...>) {
+      return details::invoke_dispatch<D, R>(static_cast<L>(
+          *static_cast<T1*>(lhs)), static_cast<Rt>(*static_cast<T2*>(rhs)),
+          std::forward<Args>(args)...);
+    } else {
+      return fallback(lhs, rhs, std::forward<Args>(args)...);
+    }
+  }
+  static R fallback(void*, void*, Args... args) {
+    if constexpr (std::is_invocable_r_v<
+        R, D, std::nullptr_t, std::nullptr_t, Args...>) {
+      return details::invoke_dispatch<D, R>(
+          nullptr, nullptr, std::forward<Args>(args)...);
+    } else {
+      ___PRO_THROW(not_implemented{});
+    }
+  }
+  using row_type = std::array<entry_type, sizeof...(Ts) + 1u>;
+  template <bool C1, bool C2, class T1>
+  static constexpr row_type row() noexcept
+      { return {&entry<C1, C2, T1, Ts>..., &fallback}; }
+  static constexpr row_type fallback_row() noexcept {
+    row_type result{};
+    for (auto& e : result) { e = &fallback; }
+    return result;
+  }
+  using table_type = std::array<row_type, sizeof...(Ts) + 1u>;
+  // Indexed by the constness of each side.
+  template <bool C1, bool C2>
+  static constexpr table_type table{row<C1, C2, Ts>()..., fallback_row()};
+  static constexpr const table_type* tables[2][2]{
+      {&table<false, false>, &table<false, true>},
+      {&table<true, false>, &table<true, true>}};
+};
+
+template <class MD, class F1, class F2, class... Args>
+decltype(auto) multi_invoke(proxy<F1>& lhs, proxy<F2>& rhs, Args&&... args)
+    { return MD::template invoke<false>(lhs, rhs, std::forward<Args>(args)...); }
+template <class MD, class F1, class F2, class... Args>
+decltype(auto) multi_invoke(
+    const proxy<F1>& lhs, const proxy<F2>& rhs, Args&&... args)
+    { return MD::template invoke<true>(lhs, rhs, std::forward<Args>(args)...); }
+
 #define ___PRO_EXPAND_IMPL(__X) __X
 #define ___PRO_EXPAND_MACRO_IMPL( \
     __MACRO, __1, __2, __3, __NAME, ...) \
@@ -2915,7 +5030,7 @@ struct weak_dispatch_with_handler : D {
         __MACRO, __VA_ARGS__, 3, 2)(__VA_ARGS__))
 
 #define ___PRO_DEF_MEM_ACCESSOR(__Q, __SELF, ...) \
-    template <class __F, bool __IsDirect, class __D, class __R, \
+    template <class __F, bool __IsDirect, class __D, bool __NX, class __R, \
         class... __Args> \
     struct accessor_single<__F, __IsDirect, __D, __R(__Args...) __Q> { \
       ___PRO_GEN_DEBUG_SYMBOL_FOR_MEM_ACCESSOR(__VA_ARGS__) \
@@ -2940,7 +5055,7 @@ struct weak_dispatch_with_handler : D {
     ___PRO_EXPAND_MACRO(___PRO_DEF_MEM_DISPATCH, __NAME, __VA_ARGS__)
 
 #define ___PRO_DEF_FREE_ACCESSOR(__Q, __NE, __SELF_ARG, __SELF, ...) \
-    template <class __F, bool __IsDirect, class __D, class __R, \
+    template <class __F, bool __IsDirect, class __D, bool __NX, class __R, \
         class... __Args> \
     struct accessor_single<__F, __IsDirect, __D, __R(__Args...) __Q> { \
       friend __R __VA_ARGS__(__SELF_ARG, __Args... __args) __NE { \
@@ -2948,7 +5063,7 @@ struct weak_dispatch_with_handler : D {
             __SELF, ::std::forward<__Args>(__args)...); \
       } \
 ___PRO_DEBUG( \
-      accessor_single() noexcept { ::std::ignore = &accessor_single::_symbol_guard; } \
+      constexpr accessor_single() noexcept { ::std::ignore = &accessor_single::_symbol_guard; } \
     \
      private: \
       static inline __R _symbol_guard(__SELF_ARG, __Args... __args) __NE { \
@@ -2987,6 +5102,67 @@ ___PRO_DEBUG( \
 #define PRO_DEF_FREE_AS_MEM_DISPATCH(__NAME, ...) \
     ___PRO_EXPAND_MACRO(___PRO_DEF_FREE_AS_MEM_DISPATCH, __NAME, __VA_ARGS__)
 
+// Invokes overload __O of dispatch __D on proxy __VA_ARGS__[0] through a
+// thread-local inline_cache private to the expansion site.
+#define PRO_CACHED_INVOKE(__D, __O, ...) \
+    ([&](auto&& __self, auto&&... __args) -> decltype(auto) { \
+      static thread_local ::pro::inline_cache<__D, __O> __cache; \
+      return __cache.invoke(::std::forward<decltype(__self)>(__self), \
+          ::std::forward<decltype(__args)>(__args)...); \
+    }(__VA_ARGS__))
+
+// Gives the facade being defined a constant-initialized conversion table
+// holding the registrations in __VA_ARGS__ (pro::register_inplace<T>,
+// pro::register_allocated<T, Alloc> or pro::register_pointer<T>). cast_copy
+// and cast_move into the facade search it before the runtime registry, so
+// they succeed before any proxy of it has been constructed. Use in the body
+// of the facade, e.g.
+//   struct Shape : pro::facade_builder::...::build {
+//     PRO_PRECOMPUTED_REGISTRY(pro::register_inplace<Square>);
+//   };
+// The table is then part of the facade's definition, which every
+// translation unit using the facade sees alike.
+#define PRO_PRECOMPUTED_REGISTRY(...) \
+    using precomputed_registrations = ::std::tuple<__VA_ARGS__>
+
+#define ___PRO_FOR_EACH_TYPE_1(__M, __F, __T) __M(__F, __T)
+#define ___PRO_FOR_EACH_TYPE_2(__M, __F, __T, ...) \
+    __M(__F, __T) ___PRO_EXPAND_IMPL(___PRO_FOR_EACH_TYPE_1(__M, __F, __VA_ARGS__))
+#define ___PRO_FOR_EACH_TYPE_3(__M, __F, __T, ...) \
+    __M(__F, __T) ___PRO_EXPAND_IMPL(___PRO_FOR_EACH_TYPE_2(__M, __F, __VA_ARGS__))
+#define ___PRO_FOR_EACH_TYPE_4(__M, __F, __T, ...) \
+    __M(__F, __T) ___PRO_EXPAND_IMPL(___PRO_FOR_EACH_TYPE_3(__M, __F, __VA_ARGS__))
+#define ___PRO_FOR_EACH_TYPE_5(__M, __F, __T, ...) \
+    __M(__F, __T) ___PRO_EXPAND_IMPL(___PRO_FOR_EACH_TYPE_4(__M, __F, __VA_ARGS__))
+#define ___PRO_FOR_EACH_TYPE_6(__M, __F, __T, ...) \
+    __M(__F, __T) ___PRO_EXPAND_IMPL(___PRO_FOR_EACH_TYPE_5(__M, __F, __VA_ARGS__))
+#define ___PRO_FOR_EACH_TYPE_7(__M, __F, __T, ...) \
+    __M(__F, __T) ___PRO_EXPAND_IMPL(___PRO_FOR_EACH_TYPE_6(__M, __F, __VA_ARGS__))
+#define ___PRO_FOR_EACH_TYPE_8(__M, __F, __T, ...) \
+    __M(__F, __T) ___PRO_EXPAND_IMPL(___PRO_FOR_EACH_TYPE_7(__M, __F, __VA_ARGS__))
+#define ___PRO_FOR_EACH_TYPE_IMPL(__1, __2, __3, __4, __5, __6, __7, __8, \
+    __NAME, ...) ___PRO_FOR_EACH_TYPE_##__NAME
+#define ___PRO_FOR_EACH_TYPE(__M, __F, ...) \
+    ___PRO_EXPAND_IMPL(___PRO_FOR_EACH_TYPE_IMPL( \
+        __VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1)(__M, __F, __VA_ARGS__))
+
+#define ___PRO_EXTERN_FACADE_INSTANCE(__F, __T) \
+    extern template struct ::pro::facade_instance<__F, __T>;
+#define ___PRO_INSTANTIATE_FACADE_INSTANCE(__F, __T) \
+    template struct ::pro::facade_instance<__F, __T>;
+
+// Declares pro::facade_instance<__F, T> extern for each of the (up to 8)
+// types in __VA_ARGS__; put it next to the facade in a shared header and
+// create proxies with pro::facade_instance<__F, T>::make. Exactly one
+// translation unit provides the definitions with PRO_INSTANTIATE_FACADE and
+// the same type list. Use at global scope; alias types containing commas.
+#define PRO_EXTERN_FACADE(__F, ...) \
+    ___PRO_FOR_EACH_TYPE(___PRO_EXTERN_FACADE_INSTANCE, __F, __VA_ARGS__) \
+    static_assert(true)
+#define PRO_INSTANTIATE_FACADE(__F, ...) \
+    ___PRO_FOR_EACH_TYPE(___PRO_INSTANTIATE_FACADE_INSTANCE, __F, __VA_ARGS__) \
+    static_assert(true)
+
 #define PRO_DEF_WEAK_DISPATCH(__NAME, __D, __FUNC) \
     struct [[deprecated("'PRO_DEF_WEAK_DISPATCH' is deprecated. " \
         "Use pro::weak_dispatch<" #__D "> instead.")]] __NAME : __D { \
@@ -2998,6 +5174,37 @@ ___PRO_DEBUG( \
 
 }  // namespace pro
 
+// fmt adapter: formats proxies of facades with support_format through a
+// stack buffer flushed into the output iterator. Include <fmt/format.h>
+// before this header to enable it.
+#ifdef FMT_VERSION
+namespace fmt {
+
+template <class F>
+struct formatter<pro::proxy<F>, char, std::enable_if_t<
+    pro::details::facade_traits<F>::template is_invocable<false,
+        pro::details::format_to_dispatch, pro::details::format_to_overload>>> {
+  constexpr auto parse(format_parse_context& pc) { return pc.begin(); }
+
+  template <class FormatContext>
+  auto format(const pro::proxy<F>& p, FormatContext& fc) const {
+    using out_type = decltype(fc.out());
+    out_type out = fc.out();
+    char buffer[128];
+    pro::format_sink sink{buffer, buffer + sizeof(buffer),
+        [](void* context, const char* data, std::size_t size) {
+          auto& o = *static_cast<out_type*>(context);
+          o = std::copy(data, data + size, o);
+        }, &out};
+    pro::format_to(sink, p);
+    sink.flush();
+    return out;
+  }
+};
+
+}  // namespace fmt
+#endif  // FMT_VERSION
+
 /*#if __STDC_HOSTED__
 namespace std {
 
@@ -3076,6 +5283,11 @@ struct formatter<pro::proxy_indirect_accessor<F>, CharT> {
         using __T = typename TypeN<__COUNTER__ - 3>::__T::template support_copy<copy>;      \
     };
 
+#define support_format()                                                       \
+    template <> struct TypeN<__COUNTER__> {                                    \
+        using __T = typename TypeN<__COUNTER__ - 3>::__T::support_format;      \
+    };
+
 #define support_relocate(rel)                                                     \
     template <> struct TypeN<__COUNTER__> {                                    \
         using __T = typename TypeN<__COUNTER__ - 3>::__T::template support_relocation<rel>;      \
@@ -3086,6 +5298,16 @@ struct formatter<pro::proxy_indirect_accessor<F>, CharT> {
           typename TypeN<__COUNTER__ - 3>::__T::template support_destruction<dest>;       \
     };
 
+#define embed_dispatchers(n)                                                     \
+    template <> struct TypeN<__COUNTER__> {                                    \
+        using __T = typename TypeN<__COUNTER__ - 3>::__T::template embed_dispatchers<n>;      \
+    };
+
+#define seal(...)                                                              \
+    template <> struct TypeN<__COUNTER__> {                                    \
+        using __T = typename TypeN<__COUNTER__ - 3>::__T::template seal<__VA_ARGS__>;      \
+    };
+
 #define add_direct_reflect(dest)                                                     \
     template <> struct TypeN<__COUNTER__> {                                    \
         using __T =                                                              \
@@ -3105,6 +5327,13 @@ struct formatter<pro::proxy_indirect_accessor<F>, CharT> {
           - 3>::__T::template add_convention<pro::weak_dispatch<Mem##name>, __VA_ARGS__>;                       \
     };
 
+#define fn_def_hot(name, ...)                                                \
+    PRO_DEF_MEM_DISPATCH(Mem##name, name);                                     \
+    template <> struct TypeN<__COUNTER__> {                                    \
+        using __T = typename TypeN<__COUNTER__                                   \
+          - 3>::__T::template add_hot_convention<Mem##name, __VA_ARGS__>;                       \
+    };
+
 #define add_conv(name, ...)                                                \
     template <> struct TypeN<__COUNTER__> {                                    \
         using __T = typename TypeN<__COUNTER__                                   \
@@ -3135,6 +5364,12 @@ struct formatter<pro::proxy_indirect_accessor<F>, CharT> {
           - 3>::__T::template add_convention<pro::weak_dispatch<pro::operator_dispatch<pro::operator_##name>>, __VA_ARGS__>;   \
     };
 
+#define op_def_hot(name, ...)                                                \
+    template <> struct TypeN<__COUNTER__> {                                    \
+        using __T = typename TypeN<__COUNTER__                                   \
+          - 3>::__T::template add_hot_convention<pro::operator_dispatch<pro::operator_##name>, __VA_ARGS__>;   \
+    };
+
 #define op_direct_def(name, ...)                                                \
     template <> struct TypeN<__COUNTER__> {                                    \
         using __T = typename TypeN<__COUNTER__                                   \
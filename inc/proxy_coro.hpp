@@ -0,0 +1,301 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef _MSFT_PROXY_CORO_
+#define _MSFT_PROXY_CORO_
+
+#include "proxy.hpp"
+
+// Coroutine support needs the C++20 language feature; in C++17 builds this
+// header is intentionally empty.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace pro {
+
+// Inline storage of a type-erased awaitable: enough for a coroutine handle
+// plus a few words of awaiter state.
+inline constexpr std::size_t awaitable_inline_size = 4u * sizeof(void*);
+
+namespace details {
+
+// Brings every form of await_suspend (void, bool or handle returning) to the
+// symmetric transfer form, so that a single convention covers all of them.
+template <class A>
+std::coroutine_handle<> suspend_awaitable(A& a, std::coroutine_handle<> h) {
+  using R = decltype(a.await_suspend(h));
+  if constexpr (std::is_void_v<R>) {
+    a.await_suspend(h);
+    return std::noop_coroutine();
+  } else if constexpr (std::is_same_v<R, bool>) {
+    return a.await_suspend(h) ? std::noop_coroutine() : h;
+  } else {
+    return a.await_suspend(h);
+  }
+}
+
+PRO_DEF_MEM_DISPATCH(await_ready_dispatch, await_ready);
+PRO_DEF_FREE_AS_MEM_DISPATCH(
+    await_suspend_dispatch, suspend_awaitable, await_suspend);
+PRO_DEF_MEM_DISPATCH(await_resume_dispatch, await_resume);
+
+}  // namespace details
+
+// Type-erased awaitable producing T. The accessors are named after the
+// awaiter protocol, so `co_await *p` works on any proxy of this facade; an
+// rvalue proxy can be awaited directly. Wrapped awaiters must accept a
+// std::coroutine_handle<> in await_suspend.
+template <class T, std::size_t InlineSize = awaitable_inline_size>
+struct awaitable : facade_builder
+    ::add_convention<details::await_ready_dispatch, bool()>
+    ::template add_convention<details::await_suspend_dispatch,
+        std::coroutine_handle<>(std::coroutine_handle<>)>
+    ::template add_convention<details::await_resume_dispatch, T()>
+    ::template restrict_layout<InlineSize>
+    ::build {};
+
+namespace details {
+
+template <class T, std::size_t N>
+class proxy_awaiter {
+ public:
+  explicit proxy_awaiter(proxy<awaitable<T, N>>&& p) noexcept
+      : p_(std::move(p)) {}
+  bool await_ready() { return p_->await_ready(); }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> h)
+      { return p_->await_suspend(h); }
+  T await_resume() { return p_->await_resume(); }
+
+ private:
+  proxy<awaitable<T, N>> p_;
+};
+
+// Result of awaitable_dispatch: converts into the proxy<awaitable<T>> the
+// convention returns, storing the concrete awaiter inline when it fits.
+template <class A>
+struct awaitable_box {
+  template <class F>
+  operator proxy<F>() && {
+    if constexpr (std::is_same_v<A, proxy<F>>) {
+      return std::move(value);
+    } else {
+      return make_proxy<F, A>(std::move(value));
+    }
+  }
+
+  A value;
+};
+
+}  // namespace details
+
+template <class T, std::size_t N>
+details::proxy_awaiter<T, N> operator co_await(
+    proxy<awaitable<T, N>>&& p) noexcept
+    { return details::proxy_awaiter<T, N>{std::move(p)}; }
+
+// Lets a convention return proxy<awaitable<T>> while the implementations
+// return their own concrete awaitables (or coroutine tasks).
+template <class D>
+struct awaitable_dispatch : D {
+  template <class... Args, class A = std::invoke_result_t<D&, Args...>>
+  details::awaitable_box<A> operator()(Args&&... args) noexcept(
+      std::is_nothrow_invocable_v<D&, Args...> &&
+      std::is_nothrow_move_constructible_v<A>)
+      { return {static_cast<D&>(*this)(std::forward<Args>(args)...)}; }
+};
+
+// Per-thread cache of coroutine frames in 64-byte size classes up to 1 KiB.
+// A finished frame goes back to the list of its class and is handed out to
+// the next coroutine of similar size, so steady-state task creation does not
+// reach the global allocator. Larger frames bypass the cache.
+class frame_pool {
+  static constexpr std::size_t granularity = 64u;
+  static constexpr std::size_t classes = 16u;
+  static constexpr std::size_t max_cached = 64u;
+
+  struct node { node* next; };
+  struct lists {
+    lists() = default;
+    lists(const lists&) = delete;
+    ~lists() {
+      for (node*& head : heads) {
+        while (head != nullptr) {
+          node* next = head->next;
+          ::operator delete(head);
+          head = next;
+        }
+      }
+    }
+
+    node* heads[classes] = {};
+    std::size_t counts[classes] = {};
+  };
+
+ public:
+  static void* allocate(std::size_t size) {
+    std::size_t c = class_of(size);
+    if (c < classes) {
+      lists& l = local();
+      if (node* n = l.heads[c]; n != nullptr) {
+        l.heads[c] = n->next;
+        --l.counts[c];
+        return n;
+      }
+      return ::operator new((c + 1u) * granularity);
+    }
+    return ::operator new(size);
+  }
+  static void deallocate(void* p, std::size_t size) noexcept {
+    std::size_t c = class_of(size);
+    if (c < classes) {
+      lists& l = local();
+      if (l.counts[c] < max_cached) {
+        l.heads[c] = ::new (p) node{l.heads[c]};
+        ++l.counts[c];
+        return;
+      }
+    }
+    ::operator delete(p);
+  }
+  // Number of frames currently cached by the calling thread.
+  static std::size_t cached() noexcept {
+    std::size_t result = 0u;
+    for (std::size_t count : local().counts) { result += count; }
+    return result;
+  }
+
+ private:
+  static constexpr std::size_t class_of(std::size_t size) noexcept
+      { return size == 0u ? 0u : (size - 1u) / granularity; }
+  static lists& local() noexcept {
+    static thread_local lists instance;
+    return instance;
+  }
+};
+
+template <class T = void>
+class coro_task;
+
+namespace details {
+
+template <class T>
+class coro_promise_base {
+ public:
+  template <class U>
+  void return_value(U&& value) { value_.emplace(std::forward<U>(value)); }
+  T result() {
+    rethrow();
+    return std::move(*value_);
+  }
+
+ protected:
+  void rethrow() {
+#ifdef __cpp_exceptions
+    if (exception_) { std::rethrow_exception(exception_); }
+#endif  // __cpp_exceptions
+  }
+
+  std::optional<T> value_;
+#ifdef __cpp_exceptions
+  std::exception_ptr exception_;
+#endif  // __cpp_exceptions
+};
+template <>
+class coro_promise_base<void> {
+ public:
+  void return_void() noexcept {}
+  void result() { rethrow(); }
+
+ protected:
+  void rethrow() {
+#ifdef __cpp_exceptions
+    if (exception_) { std::rethrow_exception(exception_); }
+#endif  // __cpp_exceptions
+  }
+
+#ifdef __cpp_exceptions
+  std::exception_ptr exception_;
+#endif  // __cpp_exceptions
+};
+
+}  // namespace details
+
+// Lazily started coroutine task whose frame comes from frame_pool. It is an
+// awaitable itself (resumed through symmetric transfer) and only holds the
+// coroutine handle, so it fits inline into proxy<awaitable<T>>.
+template <class T>
+class coro_task {
+ public:
+  struct promise_type : details::coro_promise_base<T> {
+    coro_task get_return_object() noexcept {
+      return coro_task{std::coroutine_handle<promise_type>::from_promise(*this)};
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    auto final_suspend() noexcept {
+      struct final_awaiter {
+        bool await_ready() noexcept { return false; }
+        std::coroutine_handle<> await_suspend(
+            std::coroutine_handle<promise_type> h) noexcept {
+          std::coroutine_handle<> next = h.promise().continuation_;
+          return next ? next : std::noop_coroutine();
+        }
+        void await_resume() noexcept {}
+      };
+      return final_awaiter{};
+    }
+    void unhandled_exception() {
+#ifdef __cpp_exceptions
+      this->exception_ = std::current_exception();
+#else
+      std::abort();
+#endif  // __cpp_exceptions
+    }
+    static void* operator new(std::size_t size)
+        { return frame_pool::allocate(size); }
+    static void operator delete(void* p, std::size_t size) noexcept
+        { frame_pool::deallocate(p, size); }
+
+    std::coroutine_handle<> continuation_;
+  };
+
+  coro_task() noexcept = default;
+  coro_task(coro_task&& rhs) noexcept
+      : h_(std::exchange(rhs.h_, nullptr)) {}
+  coro_task& operator=(coro_task&& rhs) noexcept {
+    if (this != &rhs) {
+      if (h_) { h_.destroy(); }
+      h_ = std::exchange(rhs.h_, nullptr);
+    }
+    return *this;
+  }
+  ~coro_task() { if (h_) { h_.destroy(); } }
+
+  bool valid() const noexcept { return static_cast<bool>(h_); }
+  bool done() const noexcept { return h_.done(); }
+
+  bool await_ready() const noexcept { return false; }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> c) noexcept {
+    h_.promise().continuation_ = c;
+    return h_;
+  }
+  T await_resume() { return h_.promise().result(); }
+
+ private:
+  explicit coro_task(std::coroutine_handle<promise_type> h) noexcept
+      : h_(h) {}
+
+  std::coroutine_handle<promise_type> h_;
+};
+
+}  // namespace pro
+
+#endif  // defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#endif  // _MSFT_PROXY_CORO_
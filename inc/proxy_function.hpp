@@ -0,0 +1,154 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef _MSFT_PROXY_FUNCTION_
+#define _MSFT_PROXY_FUNCTION_
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "proxy.hpp"
+
+namespace pro {
+
+// Inline buffer used when no SboSize is given; fits a lambda capturing up to
+// four pointers, so proxy<facade> stays within 48 bytes.
+inline constexpr std::size_t function_default_sbo_size = 4u * sizeof(void*);
+
+namespace details {
+
+template <class Sig, std::size_t SboSize, bool Copyable>
+struct function_facade : facade_builder
+    ::add_convention<operator_dispatch<operator_call>, Sig>
+    ::template restrict_layout<SboSize>
+    ::template support_copy<Copyable ? constraint_level::nontrivial :
+        constraint_level::none>
+    ::build {};
+
+template <bool Copyable>
+struct function_copy_guard {};
+template <>
+struct function_copy_guard<false> {
+  function_copy_guard() noexcept = default;
+  function_copy_guard(const function_copy_guard&) = delete;
+  function_copy_guard(function_copy_guard&&) noexcept = default;
+  function_copy_guard& operator=(const function_copy_guard&) = delete;
+  function_copy_guard& operator=(function_copy_guard&&) noexcept = default;
+};
+
+template <class F, class O>
+class function_invoker;
+
+// Like std::function, an unqualified signature is callable through a const
+// function as well; its target is then invoked through p_ as non-const.
+#define ___PRO_DEF_FUNCTION_INVOKER(Q, CALL_Q, SELF) \
+    template <class F, class R, class... Args> \
+    class function_invoker<F, R(Args...) Q> { \
+     public: \
+      R operator()(Args... args) CALL_Q { \
+        assert(p_.has_value()); \
+        return proxy_invoke<false, operator_dispatch<operator_call>, \
+            R(Args...) Q>(SELF, std::forward<Args>(args)...); \
+      } \
+     protected: \
+      proxy<F> p_; \
+    }
+___PRO_DEF_FUNCTION_INVOKER(, const, const_cast<proxy<F>&>(p_));
+___PRO_DEF_FUNCTION_INVOKER(noexcept, const noexcept,
+    const_cast<proxy<F>&>(p_));
+___PRO_DEF_FUNCTION_INVOKER(&, &, p_);
+___PRO_DEF_FUNCTION_INVOKER(& noexcept, & noexcept, p_);
+___PRO_DEF_FUNCTION_INVOKER(&&, &&, std::move(p_));
+___PRO_DEF_FUNCTION_INVOKER(&& noexcept, && noexcept, std::move(p_));
+___PRO_DEF_FUNCTION_INVOKER(const, const, p_);
+___PRO_DEF_FUNCTION_INVOKER(const noexcept, const noexcept, p_);
+___PRO_DEF_FUNCTION_INVOKER(const&, const&, p_);
+___PRO_DEF_FUNCTION_INVOKER(const& noexcept, const& noexcept, p_);
+___PRO_DEF_FUNCTION_INVOKER(const&&, const&&, std::move(p_));
+___PRO_DEF_FUNCTION_INVOKER(const&& noexcept, const&& noexcept, std::move(p_));
+#undef ___PRO_DEF_FUNCTION_INVOKER
+
+// Whether make_proxy<F> accepts a T, i.e. T is invocable as the signature
+// of F requires, with either inline or allocated storage.
+template <class F, class T>
+constexpr bool is_function_target = proxiable<inplace_ptr<T>, F> ||
+    proxiable<allocated_ptr<T, std::allocator<T>>, F> ||
+    proxiable<compact_ptr<T, std::allocator<T>>, F>;
+template <class F, class T>
+constexpr bool is_function_argument =
+    !details::is_in_place_type<T> && !std::is_same_v<T, std::nullptr_t> &&
+    (std::is_same_v<T, proxy<F>> || is_function_target<F, T>);
+
+template <class T>
+constexpr bool is_null_callable(const T& fn) noexcept {
+  if constexpr (std::is_pointer_v<T> || std::is_member_pointer_v<T>) {
+    return fn == nullptr;
+  } else {
+    return false;
+  }
+}
+
+}  // namespace details
+
+// Type-erased callable with a configurable inline buffer. Callables that do
+// not fit into SboSize bytes (or are over-aligned) are heap allocated. The
+// copyable flavour requires copy-constructible targets, like std::function;
+// the move-only flavour accepts any nothrow-movable callable.
+template <class Sig, std::size_t SboSize, bool Copyable>
+class basic_function
+    : public details::function_invoker<
+          details::function_facade<Sig, SboSize, Copyable>, Sig>,
+      private details::function_copy_guard<Copyable> {
+ public:
+  using facade_type = details::function_facade<Sig, SboSize, Copyable>;
+
+  basic_function() noexcept = default;
+  basic_function(std::nullptr_t) noexcept {}
+  // Like std::function, only takes part in overload resolution for targets
+  // invocable as Sig (or a proxy of the facade itself).
+  template <class T, class = std::enable_if_t<
+      !std::is_same_v<std::decay_t<T>, basic_function> &&
+      details::is_function_argument<facade_type, std::decay_t<T>>>>
+  basic_function(T&& fn) {
+    if constexpr (std::is_same_v<std::decay_t<T>, proxy<facade_type>>) {
+      this->p_ = std::forward<T>(fn);
+    } else if (!details::is_null_callable(fn)) {
+      this->p_ = make_proxy<facade_type>(std::forward<T>(fn));
+    }
+  }
+  template <class T, class... Args>
+  explicit basic_function(std::in_place_type_t<T>, Args&&... args)
+      { this->p_ = make_proxy<facade_type, T>(std::forward<Args>(args)...); }
+
+  basic_function(const basic_function&) = default;
+  basic_function(basic_function&&) noexcept = default;
+  basic_function& operator=(const basic_function&) = default;
+  basic_function& operator=(basic_function&&) noexcept = default;
+  basic_function& operator=(std::nullptr_t) noexcept
+      { this->p_.reset(); return *this; }
+  template <class T, class = std::enable_if_t<
+      !std::is_same_v<std::decay_t<T>, basic_function> &&
+      details::is_function_argument<facade_type, std::decay_t<T>>>>
+  basic_function& operator=(T&& fn)
+      { return *this = basic_function{std::forward<T>(fn)}; }
+
+  explicit operator bool() const noexcept { return this->p_.has_value(); }
+  void swap(basic_function& rhs) noexcept { std::swap(this->p_, rhs.p_); }
+  friend void swap(basic_function& lhs, basic_function& rhs) noexcept
+      { lhs.swap(rhs); }
+  friend bool operator==(const basic_function& f, std::nullptr_t) noexcept
+      { return !f; }
+  friend bool operator!=(const basic_function& f, std::nullptr_t) noexcept
+      { return static_cast<bool>(f); }
+};
+
+template <class Sig, std::size_t SboSize = function_default_sbo_size>
+using function = basic_function<Sig, SboSize, true>;
+template <class Sig, std::size_t SboSize = function_default_sbo_size>
+using move_only_function = basic_function<Sig, SboSize, false>;
+
+}  // namespace pro
+
+#endif  // _MSFT_PROXY_FUNCTION_
@@ -0,0 +1,443 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef _MSFT_PROXY_MMAP_
+#define _MSFT_PROXY_MMAP_
+
+#include "proxy.hpp"
+
+// The mapped heap needs POSIX mmap; elsewhere this header is intentionally
+// empty.
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace pro {
+
+namespace details {
+
+// "XPRPHEA3"; the layout with named, self-checking records.
+inline constexpr std::uint64_t mapped_heap_magic = 0x3341454850525058ull;
+inline constexpr std::size_t mapped_heap_granularity = 16u;
+
+// used is published with release semantics once a block is complete, so a
+// process mapping the same heap never sees a half-written object.
+struct mapped_heap_header {
+  std::uint64_t magic;
+  std::uint64_t capacity;
+  std::atomic<std::uint64_t> used;
+  std::atomic<std::uint64_t> count;
+};
+
+// Precedes every block of the heap. type_id is the stable id of the stored
+// object, 0 for untyped blocks. name and name_size locate the type name
+// behind type_id, itself stored in an untyped block, so that a colliding id
+// is not taken for the type. check binds the record to the offset of its
+// object (see mapped_heap_check), so that a handle is validated without
+// walking the heap; reserved is kept zero.
+struct mapped_heap_record {
+  std::uint64_t type_id;
+  std::uint64_t size;
+  std::uint64_t name;
+  std::uint64_t name_size;
+  std::uint64_t check;
+  std::uint64_t reserved;
+};
+
+constexpr std::uint64_t mapped_heap_check(std::uint64_t offset) noexcept
+    { return offset ^ mapped_heap_magic; }
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+    "The header of a mapped heap is shared between processes");
+static_assert(sizeof(mapped_heap_header) % mapped_heap_granularity == 0u);
+static_assert(sizeof(mapped_heap_record) % mapped_heap_granularity == 0u);
+
+// Id of T inside a mapped heap: the hash of its name, which stays the same
+// across runs of binaries built by the same toolchain. It matches the key
+// of register_pointer<T> in a precomputed registry.
+template <class T>
+constexpr std::uint64_t mapped_type_id =
+    static_type_token{std::in_place_type<T*>}->hash;
+template <class T>
+constexpr std::string_view mapped_type_name =
+    static_type_token{std::in_place_type<T*>}->type_name;
+
+}  // namespace details
+
+// Position-independent handle to an object of a mapped heap: its offset
+// from the start of the mapping. It stays valid in every process mapping
+// the heap and may itself be stored there.
+struct mapped_ref {
+  std::uint64_t offset;
+};
+
+// Append-only heap in a memory-mapped file. Objects are stored together
+// with a stable type id and name instead of a meta pointer, so a heap
+// written by one run can be mapped by the next one and viewed through
+// proxies again without reconstructing its objects: load() resolves each id
+// through the PRO_PRECOMPUTED_REGISTRY in the facade, which must list
+// pro::register_pointer<T> for every stored type. Stored types must be
+// trivially copyable, since they are reused at whatever address the file is
+// mapped. Blocks are never freed.
+//
+// Processes built from the same binary can share a heap through map() on a
+// memfd or shm_open descriptor and hand objects over as mapped_ref. There
+// may be one writer at a time; readers only see complete objects.
+class mapped_heap {
+ public:
+  // Maps the heap in the file at path, creating it with the given capacity
+  // when it does not exist yet. Returns nullopt when the file cannot be
+  // opened or mapped, or holds something else.
+  static std::optional<mapped_heap> open(const char* path,
+      std::size_t capacity) noexcept {
+    int fd = ::open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) { return std::nullopt; }
+    std::optional<mapped_heap> result = map(fd, capacity);
+    ::close(fd);
+    return result;
+  }
+
+  // Same as open() on a descriptor the caller keeps owning, e.g. one from
+  // memfd_create or shm_open. An empty file is sized to capacity first.
+  static std::optional<mapped_heap> map(int fd, std::size_t capacity) noexcept {
+    struct stat st;
+    if (::fstat(fd, &st) != 0) { return std::nullopt; }
+    bool fresh = st.st_size == 0;
+    if (fresh) {
+      capacity = align_up(std::max(capacity,
+          sizeof(details::mapped_heap_header)));
+      if (::ftruncate(fd, static_cast<off_t>(capacity)) != 0)
+          { return std::nullopt; }
+    } else {
+      capacity = static_cast<std::size_t>(st.st_size);
+    }
+    void* base = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED,
+        fd, 0);
+    if (base == MAP_FAILED) { return std::nullopt; }
+    mapped_heap result{static_cast<std::byte*>(base), capacity};
+    if (fresh) {
+      ::new (base) details::mapped_heap_header{details::mapped_heap_magic,
+          capacity, {sizeof(details::mapped_heap_header)}, {0u}};
+    } else if (capacity < sizeof(details::mapped_heap_header) ||
+        result.header().magic != details::mapped_heap_magic ||
+        result.header().capacity != capacity ||
+        result.used() > capacity) {
+      return std::nullopt;
+    }
+    return result;
+  }
+
+  mapped_heap(mapped_heap&& rhs) noexcept
+      : base_(std::exchange(rhs.base_, nullptr)),
+        capacity_(std::exchange(rhs.capacity_, 0u)),
+        names_(std::move(rhs.names_)) {}
+  mapped_heap& operator=(mapped_heap&& rhs) noexcept {
+    if (this != &rhs) {
+      unmap();
+      base_ = std::exchange(rhs.base_, nullptr);
+      capacity_ = std::exchange(rhs.capacity_, 0u);
+      names_ = std::move(rhs.names_);
+    }
+    return *this;
+  }
+  ~mapped_heap() { unmap(); }
+
+  // Constructs a T in the heap, or returns nullptr once it is full.
+  template <class T, class... Args>
+  T* emplace(Args&&... args) {
+    std::size_t end;
+    void* p = reserve_object<T>(end);
+    if (p == nullptr) { return nullptr; }
+    T* result = ::new (p) T(std::forward<Args>(args)...);
+    header().count.fetch_add(1u, std::memory_order_relaxed);
+    header().used.store(end, std::memory_order_release);
+    return result;
+  }
+
+  // Storage for one T that the caller constructs, or nullptr once the heap
+  // is full. load() views it like an object of emplace(), but other
+  // processes see the block before the object is complete. Used by
+  // mapped_allocator.
+  template <class T>
+  void* allocate() {
+    std::size_t end;
+    void* result = reserve_object<T>(end);
+    if (result != nullptr) {
+      header().count.fetch_add(1u, std::memory_order_relaxed);
+      header().used.store(end, std::memory_order_release);
+    }
+    return result;
+  }
+  // Untyped storage, skipped by load().
+  void* allocate(std::size_t size, std::size_t align) noexcept {
+    std::size_t end;
+    void* result = reserve_block(0u, size, align, end);
+    if (result != nullptr)
+        { header().used.store(end, std::memory_order_release); }
+    return result;
+  }
+
+  // Handle of an object returned by emplace().
+  mapped_ref ref(const void* object) const noexcept {
+    return mapped_ref{static_cast<std::uint64_t>(
+        static_cast<const std::byte*>(object) - base_)};
+  }
+  // The T that r refers to, or nullptr when r denotes something else.
+  template <class T>
+  T* at(mapped_ref r) const noexcept {
+    const details::mapped_heap_record* record = record_of(r);
+    return record != nullptr && record->type_id == details::mapped_type_id<T>
+        ? reinterpret_cast<T*>(base_ + r.offset) : nullptr;
+  }
+  // Non-owning proxy to the object r refers to, or an empty proxy when r
+  // does not denote a complete object of a type listed for F.
+  template <class F>
+  proxy<F> get(mapped_ref r) const noexcept {
+    static_assert(details::facade_registry<F>::enabled,
+        "F needs a PRO_PRECOMPUTED_REGISTRY listing the stored types");
+    proxy<F> result;
+    const details::mapped_heap_record* record = record_of(r);
+    if (record != nullptr && record->type_id != 0u) {
+      if (auto entry = find_entry<F>(*record, used()); entry != nullptr)
+          { assign(result, *entry, base_ + r.offset); }
+    }
+    return result;
+  }
+
+  // Views every object stored with emplace() or allocate<T>(), in insertion
+  // order, through non-owning proxies. Objects of types the registry of F
+  // does not list come back as empty proxies. Returns no proxies at all
+  // when a record of the heap is corrupt.
+  template <class F>
+  std::vector<proxy<F>> load() const {
+    static_assert(details::facade_registry<F>::enabled,
+        "F needs a PRO_PRECOMPUTED_REGISTRY listing the stored types");
+    std::size_t used = this->used();
+    std::vector<proxy<F>> result;
+    if (used > capacity_) { return result; }
+    result.reserve(size());
+    const details::mapped_heap_record* last = nullptr;
+    const typename details::facade_registry<F>::entry_type* entry = nullptr;
+    bool valid = walk(used, [&](const details::mapped_heap_record& record,
+        std::size_t offset) {
+      if (record.type_id != 0u) {
+        // Neighbouring objects tend to share a type; skip the search then.
+        if (last == nullptr || record.type_id != last->type_id ||
+            record.name != last->name) {
+          last = &record;
+          entry = find_entry<F>(record, used);
+        }
+        proxy<F>& p = result.emplace_back();
+        if (entry != nullptr) { assign(p, *entry, base_ + offset); }
+      }
+      return true;
+    });
+    if (!valid) { result.clear(); }
+    return result;
+  }
+
+  std::size_t size() const noexcept {
+    return static_cast<std::size_t>(
+        header().count.load(std::memory_order_relaxed));
+  }
+  std::size_t used() const noexcept {
+    return static_cast<std::size_t>(
+        header().used.load(std::memory_order_acquire));
+  }
+  std::size_t capacity() const noexcept { return capacity_; }
+  bool contains(const void* p) const noexcept {
+    auto b = static_cast<const std::byte*>(p);
+    return b >= base_ && b < base_ + capacity_;
+  }
+
+ private:
+  mapped_heap(std::byte* base, std::size_t capacity) noexcept
+      : base_(base), capacity_(capacity), names_() {}
+
+  static constexpr std::size_t align_up(std::size_t n) noexcept {
+    return (n + details::mapped_heap_granularity - 1u) &
+        ~(details::mapped_heap_granularity - 1u);
+  }
+  details::mapped_heap_header& header() const noexcept
+      { return *reinterpret_cast<details::mapped_heap_header*>(base_); }
+
+  // Calls fn(record, offset of the object) for the blocks below used, in
+  // order, until it returns false. Returns false if a record does not fit
+  // within used.
+  template <class Fn>
+  bool walk(std::size_t used, Fn&& fn) const {
+    for (std::size_t offset = sizeof(details::mapped_heap_header);
+        offset < used;) {
+      if (used - offset < sizeof(details::mapped_heap_record)) { return false; }
+      auto& record =
+          *reinterpret_cast<const details::mapped_heap_record*>(base_ + offset);
+      offset += sizeof(details::mapped_heap_record);
+      if (record.check != details::mapped_heap_check(offset) ||
+          record.size > used - offset ||
+          record.size % details::mapped_heap_granularity != 0u)
+          { return false; }
+      if (!fn(record, offset)) { return true; }
+      offset += static_cast<std::size_t>(record.size);
+    }
+    return true;
+  }
+
+  // Record of the block r points to, if r is the start of a complete one.
+  // The check word of the record in front of it tells a block from the
+  // middle of an object, or from a copy of a record made elsewhere.
+  const details::mapped_heap_record* record_of(mapped_ref r) const noexcept {
+    std::size_t used = this->used();
+    if (r.offset % details::mapped_heap_granularity != 0u || r.offset > used ||
+        used > capacity_ || r.offset < sizeof(details::mapped_heap_header) +
+            sizeof(details::mapped_heap_record)) { return nullptr; }
+    auto& record = *reinterpret_cast<const details::mapped_heap_record*>(
+        base_ + r.offset - sizeof(details::mapped_heap_record));
+    return record.check == details::mapped_heap_check(r.offset) &&
+        record.size <= used - r.offset ? &record : nullptr;
+  }
+
+  // Writes the record of a block but leaves publishing it to the caller.
+  void* reserve_block(std::uint64_t type_id, std::size_t size,
+      std::size_t align, std::size_t& end, std::uint64_t name = 0u,
+      std::uint64_t name_size = 0u) noexcept {
+    if (align > details::mapped_heap_granularity) { return nullptr; }
+    size = align_up(size);
+    std::size_t offset = used();
+    if (capacity_ - offset < sizeof(details::mapped_heap_record) + size)
+        { return nullptr; }
+    std::size_t object = offset + sizeof(details::mapped_heap_record);
+    ::new (base_ + offset) details::mapped_heap_record{type_id, size, name,
+        name_size, details::mapped_heap_check(object), 0u};
+    end = object + size;
+    return base_ + object;
+  }
+
+  // Reserves a block for a T, writing its name first unless this process
+  // did so already.
+  template <class T>
+  void* reserve_object(std::size_t& end) {
+    static_assert(std::is_trivially_copyable_v<T>,
+        "Objects of a mapped heap are reused without being reconstructed");
+    constexpr std::uint64_t id = details::mapped_type_id<T>;
+    constexpr std::string_view name = details::mapped_type_name<T>;
+    auto iter = std::find_if(names_.begin(), names_.end(),
+        [&](const std::pair<std::uint64_t, std::uint64_t>& n)
+            { return n.first == id; });
+    std::uint64_t name_offset;
+    if (iter != names_.end()) {
+      name_offset = iter->second;
+    } else {
+      std::size_t name_end;
+      void* p = reserve_block(0u, name.size(), 1u, name_end);
+      if (p == nullptr) { return nullptr; }
+      std::copy(name.begin(), name.end(), static_cast<char*>(p));
+      header().used.store(name_end, std::memory_order_release);
+      name_offset = static_cast<std::uint64_t>(static_cast<std::byte*>(p) -
+          base_);
+      names_.emplace_back(id, name_offset);
+    }
+    return reserve_block(id, sizeof(T), alignof(T), end, name_offset,
+        name.size());
+  }
+
+  template <class F, class E>
+  static void assign(proxy<F>& p, const E& entry, std::byte* object) noexcept {
+    entry.create_ptr_copy(p.ptr_, reinterpret_cast<std::byte*>(&object),
+        nullptr);
+    p.meta_ = entry.meta;
+  }
+
+  // Raw pointer entry of F for the type of record, matched by id and name.
+  template <class F>
+  const typename details::facade_registry<F>::entry_type* find_entry(
+      const details::mapped_heap_record& record, std::size_t used) const
+      noexcept {
+    if (record.name < sizeof(details::mapped_heap_header) ||
+        record.name > used || record.name_size > used - record.name)
+        { return nullptr; }
+    std::string_view name{reinterpret_cast<const char*>(base_ + record.name),
+        static_cast<std::size_t>(record.name_size)};
+    auto [first, last] =
+        details::facade_registry<F>::equal_range(record.type_id);
+    for (; first != last; ++first) {
+      if (first->type == details::static_meta_manager::ptr_type::raw &&
+          first->proxiable_type->type_name == name) { return first; }
+    }
+    return nullptr;
+  }
+
+  void unmap() noexcept {
+    if (base_ != nullptr) { ::munmap(base_, capacity_); }
+  }
+
+  std::byte* base_;
+  std::size_t capacity_;
+  // Offsets of the type names this process wrote, by type id.
+  std::vector<std::pair<std::uint64_t, std::uint64_t>> names_;
+};
+
+// Allocator over a mapped_heap, so that allocate_proxy can place objects in
+// the mapping. Deallocation is a no-op.
+template <class T>
+class mapped_allocator {
+ public:
+  using value_type = T;
+
+  explicit mapped_allocator(mapped_heap& heap) noexcept : heap_(&heap) {}
+  template <class U>
+  mapped_allocator(const mapped_allocator<U>& rhs) noexcept
+      : heap_(rhs.heap()) {}
+
+  // A single trivially copyable T is recorded with its type, so that
+  // objects of allocate_proxy can be loaded again.
+  T* allocate(std::size_t n) {
+    void* result;
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      result = n == 1u ? heap_->allocate<T>()
+          : heap_->allocate(n * sizeof(T), alignof(T));
+    } else {
+      result = heap_->allocate(n * sizeof(T), alignof(T));
+    }
+    if (result == nullptr) {
+#ifdef __cpp_exceptions
+      throw std::bad_alloc{};
+#else
+      std::abort();
+#endif  // __cpp_exceptions
+    }
+    return static_cast<T*>(result);
+  }
+  void deallocate(T*, std::size_t) noexcept {}
+
+  mapped_heap* heap() const noexcept { return heap_; }
+  template <class U>
+  bool operator==(const mapped_allocator<U>& rhs) const noexcept
+      { return heap_ == rhs.heap(); }
+  template <class U>
+  bool operator!=(const mapped_allocator<U>& rhs) const noexcept
+      { return heap_ != rhs.heap(); }
+
+ private:
+  mapped_heap* heap_;
+};
+
+}  // namespace pro
+
+#endif  // __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+
+#endif  // _MSFT_PROXY_MMAP_
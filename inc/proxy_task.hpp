@@ -0,0 +1,499 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#ifndef _MSFT_PROXY_TASK_
+#define _MSFT_PROXY_TASK_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "proxy.hpp"
+
+namespace pro {
+
+// Inline storage of a task, large enough for a lambda capturing a handful of
+// pointers/references. Bigger callables fall back to an allocated pointer.
+inline constexpr std::size_t task_inline_size = 6u * sizeof(void*);
+
+struct task : facade_builder
+    ::add_convention<operator_dispatch<operator_call>, void() &&>
+    ::restrict_layout<task_inline_size>
+    ::build {};
+
+namespace details {
+
+// Bounded Chase-Lev deque. The owner pushes and pops at the bottom, thieves
+// steal from the top. Each slot carries an `occupied` flag so that the owner
+// never overwrites a task a thief has claimed but not yet moved out; a full
+// deque (or a busy slot) makes push() fail and the caller spills elsewhere.
+class task_deque {
+  struct slot {
+    std::atomic<bool> occupied{false};
+    proxy<task> value;
+  };
+
+ public:
+  explicit task_deque(std::size_t capacity)
+      : mask_(capacity - 1u), slots_(std::make_unique<slot[]>(capacity)) {}
+  task_deque(const task_deque&) = delete;
+  task_deque& operator=(const task_deque&) = delete;
+
+  bool push(proxy<task>& t) noexcept {
+    std::int64_t b = bottom_.load(std::memory_order_relaxed);
+    std::int64_t tp = top_.load(std::memory_order_acquire);
+    if (b - tp > static_cast<std::int64_t>(mask_)) { return false; }
+    slot& s = slots_[static_cast<std::size_t>(b) & mask_];
+    if (s.occupied.load(std::memory_order_acquire)) { return false; }
+    s.value = std::move(t);
+    s.occupied.store(true, std::memory_order_relaxed);
+    bottom_.store(b + 1, std::memory_order_release);
+    return true;
+  }
+
+  proxy<task> pop() noexcept {
+    std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t tp = top_.load(std::memory_order_relaxed);
+    proxy<task> result;
+    if (tp <= b) {
+      if (tp == b) {
+        if (!top_.compare_exchange_strong(tp, tp + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed)) {
+          bottom_.store(b + 1, std::memory_order_relaxed);
+          return result;
+        }
+        bottom_.store(b + 1, std::memory_order_relaxed);
+      }
+      take(slots_[static_cast<std::size_t>(b) & mask_], result);
+    } else {
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  proxy<task> steal() noexcept {
+    std::int64_t tp = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t b = bottom_.load(std::memory_order_acquire);
+    proxy<task> result;
+    if (tp < b && top_.compare_exchange_strong(tp, tp + 1,
+        std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      take(slots_[static_cast<std::size_t>(tp) & mask_], result);
+    }
+    return result;
+  }
+
+  bool empty() const noexcept {
+    return bottom_.load(std::memory_order_acquire) <=
+        top_.load(std::memory_order_acquire);
+  }
+
+ private:
+  static void take(slot& s, proxy<task>& out) noexcept {
+    out = std::move(s.value);
+    s.value.reset();
+    s.occupied.store(false, std::memory_order_release);
+  }
+
+  alignas(64) std::atomic<std::int64_t> top_{0};
+  alignas(64) std::atomic<std::int64_t> bottom_{0};
+  const std::size_t mask_;
+  std::unique_ptr<slot[]> slots_;
+};
+
+constexpr std::size_t round_up_pow2(std::size_t n) noexcept {
+  std::size_t r = 1u;
+  while (r < n) { r <<= 1; }
+  return r;
+}
+
+}  // namespace details
+
+// Thread pool whose workers own a Chase-Lev deque of proxy<task>. Tasks
+// submitted from a worker go to that worker's deque (LIFO for the owner),
+// tasks from outside go to a shared injection queue, and idle workers steal
+// from random victims before going to sleep. Tasks must not throw.
+class work_stealing_pool {
+  struct worker {
+    explicit worker(std::size_t capacity) : queue(capacity) {}
+    details::task_deque queue;
+    std::uint64_t seed = 0;
+    std::thread thread;
+  };
+  struct context {
+    work_stealing_pool* pool;
+    std::size_t index;
+  };
+
+ public:
+  explicit work_stealing_pool(
+      std::size_t threads = std::thread::hardware_concurrency(),
+      std::size_t deque_capacity = 1024u) {
+    if (threads == 0u) { threads = 1u; }
+    deque_capacity = details::round_up_pow2(deque_capacity);
+    workers_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+      workers_.push_back(std::make_unique<worker>(deque_capacity));
+      workers_.back()->seed = 0x9E3779B97F4A7C15ull * (i + 1u);
+    }
+    for (std::size_t i = 0; i < threads; ++i) {
+      workers_[i]->thread = std::thread{[this, i] { run(i); }};
+    }
+  }
+  work_stealing_pool(const work_stealing_pool&) = delete;
+  work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+  ~work_stealing_pool() {
+    wait_idle();
+    {
+      std::lock_guard<std::mutex> lock{sleep_mutex_};
+      stop_.store(true, std::memory_order_relaxed);
+    }
+    sleep_cv_.notify_all();
+    for (auto& w : workers_) { w->thread.join(); }
+  }
+
+  void submit(proxy<task> t) {
+    if (!t.has_value()) { return; }
+    pending_.fetch_add(1u, std::memory_order_relaxed);
+    if (current_.pool != this ||
+        !workers_[current_.index]->queue.push(t)) {
+      std::lock_guard<std::mutex> lock{injection_mutex_};
+      injection_.push_back(std::move(t));
+      injection_size_.fetch_add(1u, std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load(std::memory_order_relaxed) != 0u) {
+      std::lock_guard<std::mutex> lock{sleep_mutex_};
+      sleep_cv_.notify_one();
+    }
+  }
+  template <class T, class = std::enable_if_t<
+      !std::is_same_v<std::decay_t<T>, proxy<task>>>>
+  void submit(T&& fn) { submit(make_proxy<task>(std::forward<T>(fn))); }
+
+  // Blocks until every submitted task (including the ones spawned by tasks)
+  // has finished. Must not be called from a worker thread.
+  void wait_idle() {
+    std::unique_lock<std::mutex> lock{idle_mutex_};
+    idle_cv_.wait(lock, [this] {
+      return pending_.load(std::memory_order_acquire) == 0u;
+    });
+  }
+
+  std::size_t size() const noexcept { return workers_.size(); }
+
+ private:
+  proxy<task> pop_injection() {
+    if (injection_size_.load(std::memory_order_relaxed) == 0u) { return {}; }
+    std::lock_guard<std::mutex> lock{injection_mutex_};
+    if (injection_.empty()) { return {}; }
+    proxy<task> result = std::move(injection_.front());
+    injection_.pop_front();
+    injection_size_.fetch_sub(1u, std::memory_order_relaxed);
+    return result;
+  }
+
+  proxy<task> find_task(std::size_t index) {
+    worker& self = *workers_[index];
+    proxy<task> result = self.queue.pop();
+    if (result.has_value()) { return result; }
+    result = pop_injection();
+    if (result.has_value()) { return result; }
+    std::size_t n = workers_.size();
+    if (n > 1u) {
+      self.seed ^= self.seed << 13;
+      self.seed ^= self.seed >> 7;
+      self.seed ^= self.seed << 17;
+      std::size_t start = static_cast<std::size_t>(self.seed % n);
+      for (std::size_t i = 0; i < n; ++i) {
+        std::size_t victim = (start + i) % n;
+        if (victim == index) { continue; }
+        result = workers_[victim]->queue.steal();
+        if (result.has_value()) { return result; }
+      }
+    }
+    return result;
+  }
+
+  bool has_work() const noexcept {
+    if (injection_size_.load(std::memory_order_relaxed) != 0u) { return true; }
+    for (auto& w : workers_) {
+      if (!w->queue.empty()) { return true; }
+    }
+    return false;
+  }
+
+  void run(std::size_t index) noexcept {
+    current_ = context{this, index};
+    for (;;) {
+      proxy<task> t = find_task(index);
+      for (int spin = 0; !t.has_value() && spin < 64; ++spin) {
+        std::this_thread::yield();
+        t = find_task(index);
+      }
+      if (t.has_value()) {
+        (*std::move(t))();
+        t.reset();
+        if (pending_.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+          std::lock_guard<std::mutex> lock{idle_mutex_};
+          idle_cv_.notify_all();
+        }
+        continue;
+      }
+      std::unique_lock<std::mutex> lock{sleep_mutex_};
+      sleepers_.fetch_add(1u, std::memory_order_seq_cst);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      sleep_cv_.wait(lock, [this] {
+        return stop_.load(std::memory_order_relaxed) || has_work();
+      });
+      sleepers_.fetch_sub(1u, std::memory_order_relaxed);
+      if (stop_.load(std::memory_order_relaxed) && !has_work()) { break; }
+    }
+    current_ = context{nullptr, 0u};
+  }
+
+  std::vector<std::unique_ptr<worker>> workers_;
+  std::mutex injection_mutex_;
+  std::deque<proxy<task>> injection_;
+  std::atomic<std::size_t> injection_size_{0u};
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cv_;
+  std::atomic<std::size_t> sleepers_{0u};
+  std::atomic<bool> stop_{false};
+  std::mutex idle_mutex_;
+  std::condition_variable idle_cv_;
+  std::atomic<std::size_t> pending_{0u};
+
+  static inline thread_local context current_{nullptr, 0u};
+};
+
+namespace details {
+
+// Shared state of a task_future: one allocation, owned by the future and the
+// pending call. Waiters spin briefly, then sleep on the condition variable.
+// A reference result is kept as a pointer to the referred object.
+template <class R>
+class async_state {
+  using storage_type = std::conditional_t<std::is_void_v<R>, char,
+      std::conditional_t<std::is_reference_v<R>, std::remove_reference_t<R>*,
+          R>>;
+
+ public:
+  template <class... Args>
+  void set_value(Args&&... args) {
+    if constexpr (std::is_reference_v<R>) {
+      value_.emplace(std::addressof(args)...);
+    } else if constexpr (!std::is_void_v<R>) {
+      value_.emplace(std::forward<Args>(args)...);
+    }
+    publish();
+  }
+#ifdef __cpp_exceptions
+  void set_exception(std::exception_ptr e) noexcept {
+    exception_ = std::move(e);
+    publish();
+  }
+#endif  // __cpp_exceptions
+
+  bool ready() const noexcept { return ready_.load(std::memory_order_acquire); }
+  void wait() {
+    for (int spin = 0; spin < 64; ++spin) {
+      if (ready()) { return; }
+      std::this_thread::yield();
+    }
+    waiters_.fetch_add(1u, std::memory_order_seq_cst);
+    {
+      std::unique_lock<std::mutex> lock{mutex_};
+      cv_.wait(lock, [this] { return ready(); });
+    }
+    waiters_.fetch_sub(1u, std::memory_order_relaxed);
+  }
+  R get() {
+    wait();
+#ifdef __cpp_exceptions
+    if (exception_) { std::rethrow_exception(exception_); }
+#endif  // __cpp_exceptions
+    if constexpr (std::is_reference_v<R>) {
+      return static_cast<R>(**value_);
+    } else if constexpr (!std::is_void_v<R>) {
+      return std::move(*value_);
+    }
+  }
+
+  void add_ref() noexcept { refs_.fetch_add(1u, std::memory_order_relaxed); }
+  void release() noexcept {
+    if (refs_.fetch_sub(1u, std::memory_order_acq_rel) == 1u) { delete this; }
+  }
+
+ private:
+  void publish() {
+    ready_.store(true, std::memory_order_seq_cst);
+    if (waiters_.load(std::memory_order_seq_cst) != 0u) {
+      std::lock_guard<std::mutex> lock{mutex_};
+      cv_.notify_all();
+    }
+  }
+
+  std::atomic<bool> ready_{false};
+  std::atomic<std::uint32_t> refs_{1u};
+  std::atomic<std::uint32_t> waiters_{0u};
+  std::optional<storage_type> value_;
+#ifdef __cpp_exceptions
+  std::exception_ptr exception_;
+#endif  // __cpp_exceptions
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+template <class F, bool View>
+using async_capture_t = std::conditional_t<View, proxy<F>*, proxy<F>>;
+
+// The task enqueued by invoke_async. Holds the proxy (moved in, so the
+// pointee is relocated through the proxy's own relocation dispatcher rather
+// than copied or reallocated) or a pointer to it, plus the arguments.
+template <class D, class O, bool IsDirect, class F, bool View, class... Args>
+class async_call {
+  using traits = overload_traits<O>;
+  using R = typename traits::return_type;
+
+ public:
+  template <class P, class... Ts>
+  async_call(P&& p, async_state<R>* state, Ts&&... args)
+      : p_(std::forward<P>(p)), state_(state),
+        args_(std::forward<Ts>(args)...) {}
+  async_call(async_call&& rhs) noexcept(
+      std::is_nothrow_move_constructible_v<std::tuple<Args...>>)
+      : p_(std::move(rhs.p_)), state_(std::exchange(rhs.state_, nullptr)),
+        args_(std::move(rhs.args_)) {}
+  async_call(const async_call&) = delete;
+  ~async_call() { if (state_ != nullptr) { state_->release(); } }
+
+  void operator()() && noexcept {
+#ifdef __cpp_exceptions
+    try {
+#endif  // __cpp_exceptions
+      if constexpr (std::is_void_v<R>) {
+        std::apply([this](auto&... args) { this->call(args...); }, args_);
+        state_->set_value();
+      } else {
+        state_->set_value(std::apply(
+            [this](auto&... args) -> R { return this->call(args...); }, args_));
+      }
+#ifdef __cpp_exceptions
+    } catch (...) {
+      state_->set_exception(std::current_exception());
+    }
+#endif  // __cpp_exceptions
+  }
+
+ private:
+  template <class... Ts>
+  R call(Ts&... args) {
+    proxy<F>& p = target();
+    return proxy_invoke<IsDirect, D, O>(
+        std::forward<add_qualifier_t<proxy<F>, traits::qualifier>>(p),
+        std::move(args)...);
+  }
+  proxy<F>& target() noexcept {
+    if constexpr (View) { return *p_; } else { return p_; }
+  }
+
+  async_capture_t<F, View> p_;
+  async_state<R>* state_;
+  std::tuple<Args...> args_;
+};
+
+}  // namespace details
+
+// Lightweight single-shot future returned by invoke_async. Unlike the one of
+// std::async, destroying it does not wait for the call to finish.
+template <class R>
+class task_future {
+ public:
+  task_future() noexcept = default;
+  explicit task_future(details::async_state<R>* state) noexcept
+      : state_(state) {}
+  task_future(task_future&& rhs) noexcept
+      : state_(std::exchange(rhs.state_, nullptr)) {}
+  task_future& operator=(task_future&& rhs) noexcept {
+    if (this != &rhs) {
+      reset();
+      state_ = std::exchange(rhs.state_, nullptr);
+    }
+    return *this;
+  }
+  ~task_future() { reset(); }
+
+  bool valid() const noexcept { return state_ != nullptr; }
+  bool ready() const noexcept { return state_->ready(); }
+  void wait() const { state_->wait(); }
+  R get() {
+    details::async_state<R>* state = std::exchange(state_, nullptr);
+    struct guard {
+      ~guard() { s->release(); }
+      details::async_state<R>* s;
+    } g{state};
+    return state->get();
+  }
+
+ private:
+  void reset() noexcept {
+    if (state_ != nullptr) { std::exchange(state_, nullptr)->release(); }
+  }
+
+  details::async_state<R>* state_ = nullptr;
+};
+
+// Invokes overload O of convention D on the executor (anything with a
+// submit() accepting a callable, e.g. work_stealing_pool). An rvalue proxy is
+// moved into the task; an lvalue proxy is captured by reference and must
+// outlive the call, so O may not be an rvalue-qualified overload that would
+// consume it (pass the proxy with std::move instead). Arguments are
+// decay-copied like std::async.
+template <class D, class O, bool IsDirect = false, class E, class F,
+    class... Args>
+auto invoke_async(E& executor, proxy<F>&& p, Args&&... args)
+    -> task_future<typename details::overload_traits<O>::return_type> {
+  using R = typename details::overload_traits<O>::return_type;
+  auto* state = new details::async_state<R>();
+  task_future<R> result{state};
+  state->add_ref();
+  executor.submit(details::async_call<D, O, IsDirect, F, false,
+      std::decay_t<Args>...>{std::move(p), state,
+          std::forward<Args>(args)...});
+  return result;
+}
+template <class D, class O, bool IsDirect = false, class E, class F,
+    class... Args>
+auto invoke_async(E& executor, proxy<F>& p, Args&&... args)
+    -> task_future<typename details::overload_traits<O>::return_type> {
+  constexpr details::qualifier_type Q = details::overload_traits<O>::qualifier;
+  static_assert(Q != details::qualifier_type::rv &&
+      Q != details::qualifier_type::const_rv,
+      "An rvalue-qualified overload would consume the caller's proxy; pass "
+      "it as an rvalue to move it into the task.");
+  using R = typename details::overload_traits<O>::return_type;
+  auto* state = new details::async_state<R>();
+  task_future<R> result{state};
+  state->add_ref();
+  executor.submit(details::async_call<D, O, IsDirect, F, true,
+      std::decay_t<Args>...>{&p, state, std::forward<Args>(args)...});
+  return result;
+}
+
+}  // namespace pro
+
+#endif  // _MSFT_PROXY_TASK_
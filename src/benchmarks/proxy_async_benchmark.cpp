@@ -0,0 +1,80 @@
+#include <proxy_task.hpp>
+#include <benchmark/benchmark.h>
+#include <future>
+#include <vector>
+
+namespace proxy_async_benchmark_details {
+    PRO_DEF_MEM_DISPATCH(MemScale, Scale);
+
+    struct Scaler : pro::facade_builder ::add_convention<MemScale, int(int) const>::build {};
+
+    struct Multiplier {
+        int Scale(int v) const noexcept { return v * factor; }
+        int factor;
+    };
+
+    constexpr int kBatch = 256;
+} // namespace proxy_async_benchmark_details
+
+namespace details = proxy_async_benchmark_details;
+
+// Latency: one call offloaded and awaited at a time.
+static void BM_InvokeAsyncLatency(benchmark::State& state) {
+    pro::work_stealing_pool pool { 1u };
+    details::Multiplier m { 3 };
+    pro::proxy<details::Scaler> p = &m;
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pro::invoke_async<details::MemScale, int(int) const>(pool, p, ++i).get());
+    }
+}
+
+static void BM_StdAsyncLatency(benchmark::State& state) {
+    details::Multiplier m { 3 };
+    pro::proxy<details::Scaler> p = &m;
+    int i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::async(std::launch::async, [&p, v = ++i] { return p->Scale(v); }).get());
+    }
+}
+
+// Throughput: a batch of calls in flight before the first result is read.
+static void BM_InvokeAsyncThroughput(benchmark::State& state) {
+    pro::work_stealing_pool pool { 1u };
+    details::Multiplier m { 3 };
+    pro::proxy<details::Scaler> p = &m;
+    std::vector<pro::task_future<int>> futures(details::kBatch);
+    for (auto _ : state) {
+        for (int i = 0; i < details::kBatch; ++i) {
+            futures[i] = pro::invoke_async<details::MemScale, int(int) const>(pool, p, i);
+        }
+        int sum = 0;
+        for (auto& f : futures) {
+            sum += f.get();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * details::kBatch);
+}
+
+static void BM_StdAsyncThroughput(benchmark::State& state) {
+    details::Multiplier m { 3 };
+    pro::proxy<details::Scaler> p = &m;
+    std::vector<std::future<int>> futures(details::kBatch);
+    for (auto _ : state) {
+        for (int i = 0; i < details::kBatch; ++i) {
+            futures[i] = std::async(std::launch::async, [&p, i] { return p->Scale(i); });
+        }
+        int sum = 0;
+        for (auto& f : futures) {
+            sum += f.get();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * details::kBatch);
+}
+
+BENCHMARK(BM_InvokeAsyncLatency);
+BENCHMARK(BM_StdAsyncLatency);
+BENCHMARK(BM_InvokeAsyncThroughput);
+BENCHMARK(BM_StdAsyncThroughput);
@@ -0,0 +1,71 @@
+#include <proxy.hpp>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace proxy_dedup_benchmark_details {
+    PRO_DEF_MEM_DISPATCH(MemMix, Mix);
+
+    struct Mixer : pro::facade_builder ::add_convention<MemMix, int(int) const>::build {};
+
+    template <int K> struct Widget {
+        int Mix(int x) const noexcept {
+            unsigned h = static_cast<unsigned>(x) ^ (K * 0x9e3779b9u);
+            for (int i = 0; i < 4; ++i) {
+                h = (h ^ (h >> 13)) * (0x5bd1e995u + K + i);
+                h += static_cast<unsigned>(values[i]);
+            }
+            return static_cast<int>(h);
+        }
+        int values[4];
+    };
+
+    constexpr int kKinds = 16;
+    constexpr int kCount = 4096;
+
+    // Every widget type behind up to five pointer types; unless
+    // PRO_SHARED_DISPATCHERS is 1, each pair gets its own copy of Mix.
+    template <int K> struct Factory {
+        static pro::proxy<Mixer> make(int kind, int v) {
+            static Widget<K> shared { { v, v + 1, v + 2, v + 3 } };
+            Widget<K> w { { v, v + 1, v + 2, v + 3 } };
+            switch (kind) {
+            case 0: return pro::make_proxy_inplace<Mixer, Widget<K>>(w);
+            case 1: return &shared;
+            case 2: return std::make_unique<Widget<K>>(w);
+            case 3: return std::make_shared<Widget<K>>(w);
+            default: return pro::allocate_proxy<Mixer, Widget<K>>(std::allocator<Widget<K>> {}, w);
+            }
+        }
+    };
+
+    template <int... Ks> std::vector<pro::proxy<Mixer>> make_proxies(int kinds, std::integer_sequence<int, Ks...>) {
+        using factory = pro::proxy<Mixer> (*)(int, int);
+        constexpr factory factories[] = { &Factory<Ks>::make... };
+        std::vector<pro::proxy<Mixer>> result(kCount);
+        unsigned seed = 12345u;
+        for (int i = 0; i < kCount; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            result[i] = factories[(seed >> 16) % kKinds](static_cast<int>((seed >> 8) % kinds), i);
+        }
+        return result;
+    }
+} // namespace proxy_dedup_benchmark_details
+
+namespace details = proxy_dedup_benchmark_details;
+
+// Arg: number of pointer types in use, 1 (inline storage only) to 5.
+static void BM_PointerKindsInvoke(benchmark::State& state) {
+    auto proxies = details::make_proxies(static_cast<int>(state.range(0)), std::make_integer_sequence<int, details::kKinds> {});
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto& p : proxies) {
+            sum += p->Mix(sum);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * details::kCount);
+}
+
+BENCHMARK(BM_PointerKindsInvoke)->Arg(1)->Arg(5);
@@ -0,0 +1,34 @@
+#include <proxy.hpp>
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace proxy_format_benchmark_details {
+    PRO_DEF_FREE_DISPATCH(FreeToString, std::to_string, ToString);
+
+    struct Formattable : pro::facade_builder ::support_format ::build {};
+    struct Stringable : pro::facade_builder ::add_convention<FreeToString, std::string()>::build {};
+} // namespace proxy_format_benchmark_details
+
+namespace details = proxy_format_benchmark_details;
+
+// The value is too long for the small string buffer, so to_string allocates.
+static void BM_FormatToBuffer(benchmark::State& state) {
+    pro::proxy<details::Formattable> p = pro::make_proxy<details::Formattable>(1234567890123456789LL);
+    char buffer[32];
+    for (auto _ : state) {
+        auto r = pro::to_chars(buffer, buffer + sizeof(buffer), p);
+        benchmark::DoNotOptimize(r.ptr);
+        benchmark::ClobberMemory();
+    }
+}
+
+static void BM_ToStringConvention(benchmark::State& state) {
+    pro::proxy<details::Stringable> p = pro::make_proxy<details::Stringable>(1234567890123456789LL);
+    for (auto _ : state) {
+        std::string s = ToString(*p);
+        benchmark::DoNotOptimize(s.data());
+    }
+}
+
+BENCHMARK(BM_FormatToBuffer);
+BENCHMARK(BM_ToStringConvention);
@@ -0,0 +1,84 @@
+#include <proxy_function.hpp>
+#include <benchmark/benchmark.h>
+#include <array>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace proxy_function_benchmark_details {
+    struct SmallCallable {
+        int operator()(int v) const noexcept { return v + offset; }
+        int offset;
+    };
+    struct LargeCallable {
+        int operator()(int v) const noexcept { return v + payload[7]; }
+        std::array<int, 16> payload;
+    };
+
+    constexpr int kCount = 1000;
+
+    template <class T> T make_callable(int seed) {
+        if constexpr (std::is_same_v<T, SmallCallable>) {
+            return SmallCallable { seed };
+        } else {
+            LargeCallable result {};
+            result.payload[7] = seed;
+            return result;
+        }
+    }
+} // namespace proxy_function_benchmark_details
+
+namespace details = proxy_function_benchmark_details;
+
+template <class Fn> void BM_FunctionInvoke(benchmark::State& state) {
+    std::vector<Fn> fns;
+    for (int i = 0; i < details::kCount; ++i) {
+        fns.emplace_back(details::SmallCallable { i });
+    }
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto& fn : fns) {
+            sum += fn(1);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * details::kCount);
+}
+
+template <class Fn, class T> void BM_FunctionConstruct(benchmark::State& state) {
+    for (auto _ : state) {
+        for (int i = 0; i < details::kCount; ++i) {
+            Fn fn { details::make_callable<T>(i) };
+            benchmark::DoNotOptimize(fn);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * details::kCount);
+}
+
+template <class Fn> void BM_FunctionMove(benchmark::State& state) {
+    std::vector<Fn> src;
+    for (int i = 0; i < details::kCount; ++i) {
+        src.emplace_back(details::SmallCallable { i });
+    }
+    std::vector<Fn> dst(details::kCount);
+    for (auto _ : state) {
+        for (int i = 0; i < details::kCount; ++i) {
+            dst[i] = std::move(src[i]);
+        }
+        std::swap(src, dst);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * details::kCount);
+}
+
+BENCHMARK_TEMPLATE(BM_FunctionInvoke, std::function<int(int)>);
+BENCHMARK_TEMPLATE(BM_FunctionInvoke, pro::function<int(int)>);
+BENCHMARK_TEMPLATE(BM_FunctionInvoke, pro::move_only_function<int(int) const noexcept>);
+BENCHMARK_TEMPLATE(BM_FunctionConstruct, std::function<int(int)>, details::SmallCallable);
+BENCHMARK_TEMPLATE(BM_FunctionConstruct, pro::function<int(int)>, details::SmallCallable);
+BENCHMARK_TEMPLATE(BM_FunctionConstruct, std::function<int(int)>, details::LargeCallable);
+BENCHMARK_TEMPLATE(BM_FunctionConstruct, pro::function<int(int)>, details::LargeCallable);
+BENCHMARK_TEMPLATE(BM_FunctionConstruct, pro::function<int(int), 64u>, details::LargeCallable);
+BENCHMARK_TEMPLATE(BM_FunctionMove, std::function<int(int)>);
+BENCHMARK_TEMPLATE(BM_FunctionMove, pro::function<int(int)>);
+BENCHMARK_TEMPLATE(BM_FunctionMove, pro::move_only_function<int(int)>);
@@ -0,0 +1,170 @@
+#include <proxy.hpp>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+namespace proxy_invocation_benchmark_details {
+    struct Counter : pro::facade_builder ::add_convention<pro::operator_dispatch<pro::operator_call>, int(int)>::build {};
+
+    template <int K> struct Adder {
+        int operator()(int v) noexcept { return v + base + K; }
+        int base;
+    };
+
+    struct SealedCounter : pro::facade_builder ::add_convention<pro::operator_dispatch<pro::operator_call>, int(int)>
+        ::seal<Adder<0>, Adder<1>, Adder<2>, Adder<3>, Adder<4>, Adder<5>, Adder<6>, Adder<7>>::build {};
+
+    constexpr int kCount = 1000;
+
+    template <class F, int K> pro::proxy<F> make_adder(int base) { return pro::make_proxy<F>(Adder<K> { base }); }
+
+    // Spreads kinds distinct concrete types pseudo-randomly over the sequence.
+    template <class F = Counter> std::vector<pro::proxy<F>> make_proxies(int kinds) {
+        using factory = pro::proxy<F> (*)(int);
+        constexpr factory factories[] = { make_adder<F, 0>, make_adder<F, 1>, make_adder<F, 2>, make_adder<F, 3>,
+            make_adder<F, 4>, make_adder<F, 5>, make_adder<F, 6>, make_adder<F, 7> };
+        std::vector<pro::proxy<F>> result(kCount);
+        unsigned seed = 12345u;
+        for (int i = 0; i < kCount; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            result[i] = factories[(seed >> 16) % static_cast<unsigned>(kinds)](i);
+        }
+        return result;
+    }
+
+    using Call = pro::operator_dispatch<pro::operator_call>;
+
+    struct Vec2 {
+        double x;
+        double y;
+    };
+
+    struct Projector : pro::facade_builder ::add_convention<pro::operator_dispatch<pro::operator_call>,
+        double(const Vec2&) const noexcept>::build {};
+
+    struct VirtualProjector {
+        virtual ~VirtualProjector() = default;
+        virtual double operator()(const Vec2& v) const noexcept = 0;
+    };
+
+    template <int K> struct Axis {
+        double operator()(const Vec2& v) const noexcept { return K == 0 ? v.x : v.y; }
+    };
+
+    template <int K> struct VirtualAxis : VirtualProjector {
+        double operator()(const Vec2& v) const noexcept override { return K == 0 ? v.x : v.y; }
+    };
+} // namespace proxy_invocation_benchmark_details
+
+namespace details = proxy_invocation_benchmark_details;
+
+// Argument: number of distinct concrete types behind the call site.
+static void BM_ProxyInvoke(benchmark::State& state) {
+    auto proxies = details::make_proxies(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto& p : proxies) {
+            sum += pro::proxy_invoke<false, details::Call, int(int)>(p, 1);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * details::kCount);
+}
+
+static void BM_ProxyInvokeExpect(benchmark::State& state) {
+    auto proxies = details::make_proxies(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto& p : proxies) {
+            sum += pro::proxy_invoke_expect<details::Adder<0>, details::Call, int(int)>(p, 1);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * details::kCount);
+}
+
+static void BM_ProxyCachedInvoke(benchmark::State& state) {
+    auto proxies = details::make_proxies(static_cast<int>(state.range(0)));
+    pro::inline_cache<details::Call, int(int)> cache;
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto& p : proxies) {
+            sum += cache.invoke(p, 1);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * details::kCount);
+    state.counters["miss_rate"] = static_cast<double>(cache.misses()) / static_cast<double>(cache.hits() + cache.misses());
+}
+
+static void BM_ProxyCachedInvokeMacro(benchmark::State& state) {
+    auto proxies = details::make_proxies(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto& p : proxies) {
+            sum += PRO_CACHED_INVOKE(details::Call, int(int), p, 1);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * details::kCount);
+}
+
+static void BM_SealedProxyInvoke(benchmark::State& state) {
+    auto proxies = details::make_proxies<details::SealedCounter>(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto& p : proxies) {
+            sum += pro::proxy_invoke<false, details::Call, int(int)>(p, 1);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * details::kCount);
+}
+
+// A small struct passed as `const T&`, against the same call through a
+// virtual function.
+static void BM_ProxyInvokeSmallRefArg(benchmark::State& state) {
+    std::vector<pro::proxy<details::Projector>> proxies(details::kCount);
+    for (int i = 0; i < details::kCount; ++i) {
+        if (i % 2 == 0) {
+            proxies[i] = pro::make_proxy<details::Projector>(details::Axis<0> {});
+        } else {
+            proxies[i] = pro::make_proxy<details::Projector>(details::Axis<1> {});
+        }
+    }
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (int i = 0; i < details::kCount; ++i) {
+            sum += (*proxies[i])(details::Vec2 { static_cast<double>(i), 1.0 });
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * details::kCount);
+}
+
+static void BM_VirtualInvokeSmallRefArg(benchmark::State& state) {
+    std::vector<std::unique_ptr<details::VirtualProjector>> objects;
+    for (int i = 0; i < details::kCount; ++i) {
+        if (i % 2 == 0) {
+            objects.push_back(std::make_unique<details::VirtualAxis<0>>());
+        } else {
+            objects.push_back(std::make_unique<details::VirtualAxis<1>>());
+        }
+    }
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (int i = 0; i < details::kCount; ++i) {
+            sum += (*objects[i])(details::Vec2 { static_cast<double>(i), 1.0 });
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * details::kCount);
+}
+
+BENCHMARK(BM_ProxyInvoke)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+BENCHMARK(BM_ProxyInvokeExpect)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+BENCHMARK(BM_ProxyCachedInvoke)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+BENCHMARK(BM_ProxyCachedInvokeMacro)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+BENCHMARK(BM_SealedProxyInvoke)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+BENCHMARK(BM_ProxyInvokeSmallRefArg);
+BENCHMARK(BM_VirtualInvokeSmallRefArg);
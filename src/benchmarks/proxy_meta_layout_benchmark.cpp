@@ -0,0 +1,99 @@
+#include <proxy.hpp>
+#include <benchmark/benchmark.h>
+#include <utility>
+#include <vector>
+
+namespace proxy_meta_layout_benchmark_details {
+    PRO_DEF_MEM_DISPATCH(MemF0, f0);
+    PRO_DEF_MEM_DISPATCH(MemF1, f1);
+    PRO_DEF_MEM_DISPATCH(MemF2, f2);
+    PRO_DEF_MEM_DISPATCH(MemF3, f3);
+    PRO_DEF_MEM_DISPATCH(MemF4, f4);
+    PRO_DEF_MEM_DISPATCH(MemF5, f5);
+    PRO_DEF_MEM_DISPATCH(MemF6, f6);
+    PRO_DEF_MEM_DISPATCH(MemF7, f7);
+    PRO_DEF_MEM_DISPATCH(MemF8, f8);
+    PRO_DEF_MEM_DISPATCH(MemF9, f9);
+    PRO_DEF_MEM_DISPATCH(MemF10, f10);
+    PRO_DEF_MEM_DISPATCH(MemF11, f11);
+
+    // 12 conventions; the two called ones are declared last.
+    using ColdBuilder = pro::facade_builder ::add_convention<MemF0, int()>::add_convention<MemF1, int()>::add_convention<
+        MemF2, int()>::add_convention<MemF3, int()>::add_convention<MemF4, int()>::add_convention<MemF5, int()>::
+        add_convention<MemF6, int()>::add_convention<MemF7, int()>::add_convention<MemF8, int()>::add_convention<MemF9,
+            int()>;
+    struct ColdFacade : ColdBuilder ::add_convention<MemF10, int()>::add_convention<MemF11, int()>::build {};
+    struct HotFacade : ColdBuilder ::add_hot_convention<MemF10, int()>::add_hot_convention<MemF11, int()>::build {};
+
+    template <int K> struct Widget {
+        int f0() { return K; }
+        int f1() { return K + 1; }
+        int f2() { return K + 2; }
+        int f3() { return K + 3; }
+        int f4() { return K + 4; }
+        int f5() { return K + 5; }
+        int f6() { return K + 6; }
+        int f7() { return K + 7; }
+        int f8() { return K + 8; }
+        int f9() { return K + 9; }
+        int f10() { return K + value; }
+        int f11() { return K - value; }
+        int value;
+    };
+
+    template <std::size_t N>
+    struct EmbeddedFacade : pro::facade_builder ::add_convention<MemF0, int()>::add_convention<MemF1, int()>::
+                                add_convention<MemF2, int()>::add_convention<MemF3, int()>::add_convention<MemF4,
+                                    int()>::add_convention<MemF5, int()>::embed_dispatchers<N>::build {};
+
+    constexpr int kKinds = 32;
+    constexpr int kCount = 4096;
+
+    template <class F, int... Ks> std::vector<pro::proxy<F>> make_proxies(std::integer_sequence<int, Ks...>) {
+        using factory = pro::proxy<F> (*)(int);
+        constexpr factory factories[] = { [](int v) { return pro::make_proxy<F>(Widget<Ks> { v }); }... };
+        std::vector<pro::proxy<F>> result(kCount);
+        unsigned seed = 12345u;
+        for (int i = 0; i < kCount; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            result[i] = factories[(seed >> 16) % kKinds](i);
+        }
+        return result;
+    }
+} // namespace proxy_meta_layout_benchmark_details
+
+namespace details = proxy_meta_layout_benchmark_details;
+
+template <class F> void BM_LargeFacadeInvoke(benchmark::State& state) {
+    auto proxies = details::make_proxies<F>(std::make_integer_sequence<int, details::kKinds> {});
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto& p : proxies) {
+            sum += p->f10() + p->f11();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * details::kCount * 2);
+}
+
+BENCHMARK_TEMPLATE(BM_LargeFacadeInvoke, details::ColdFacade);
+BENCHMARK_TEMPLATE(BM_LargeFacadeInvoke, details::HotFacade);
+
+template <class F> void BM_EmbeddedDispatchersInvoke(benchmark::State& state) {
+    auto proxies = details::make_proxies<F>(std::make_integer_sequence<int, details::kKinds> {});
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto& p : proxies) {
+            sum += p->f0() + p->f1() + p->f2() + p->f3();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * details::kCount * 4);
+    state.counters["proxy_size"] = sizeof(pro::proxy<F>);
+}
+
+BENCHMARK_TEMPLATE(BM_EmbeddedDispatchersInvoke, details::EmbeddedFacade<0>);
+BENCHMARK_TEMPLATE(BM_EmbeddedDispatchersInvoke, details::EmbeddedFacade<1>);
+BENCHMARK_TEMPLATE(BM_EmbeddedDispatchersInvoke, details::EmbeddedFacade<2>);
+BENCHMARK_TEMPLATE(BM_EmbeddedDispatchersInvoke, details::EmbeddedFacade<3>);
+BENCHMARK_TEMPLATE(BM_EmbeddedDispatchersInvoke, details::EmbeddedFacade<4>);
@@ -0,0 +1,81 @@
+#include <proxy_mmap.hpp>
+#include <benchmark/benchmark.h>
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace proxy_mmap_benchmark_details {
+    PRO_DEF_MEM_DISPATCH(MemArea, Area);
+
+    struct Square {
+        int Area() const noexcept { return side * side; }
+        int side;
+    };
+    struct Rect {
+        int Area() const noexcept { return w * h; }
+        int w;
+        int h;
+    };
+
+    struct Shape : pro::facade_builder ::add_convention<MemArea, int() const>::support_copy<pro::constraint_level::nontrivial>::build {
+        PRO_PRECOMPUTED_REGISTRY(pro::register_pointer<Square>, pro::register_pointer<Rect>);
+    };
+
+    constexpr int kCount = 100000;
+
+    // A heap file holding kCount shapes, written once per process.
+    const std::string& heap_path() {
+        static const std::string path = [] {
+            char name[] = "/tmp/proxy_mmap_bench_XXXXXX";
+            close(mkstemp(name));
+            unlink(name);
+            auto heap = pro::mapped_heap::open(name, 64u * kCount);
+            for (int i = 0; i < kCount; ++i) {
+                if (i % 2 == 0) {
+                    heap->emplace<Square>(Square { i });
+                } else {
+                    heap->emplace<Rect>(Rect { i, 2 });
+                }
+            }
+            std::atexit([] { unlink(heap_path().c_str()); });
+            return std::string { name };
+        }();
+        return path;
+    }
+} // namespace proxy_mmap_benchmark_details
+
+namespace details = proxy_mmap_benchmark_details;
+
+// Maps the stored shapes and views them through proxies.
+static void BM_MappedHeapLoad(benchmark::State& state) {
+    const std::string& path = details::heap_path();
+    for (auto _ : state) {
+        auto heap = pro::mapped_heap::open(path.c_str(), 0u);
+        auto shapes = heap->load<details::Shape>();
+        benchmark::DoNotOptimize(shapes.back()->Area());
+    }
+    state.SetItemsProcessed(state.iterations() * details::kCount);
+}
+
+// The warm-up it replaces: rebuilding every object into a fresh store.
+static void BM_ReconstructProxies(benchmark::State& state) {
+    for (auto _ : state) {
+        std::vector<pro::proxy<details::Shape>> shapes(details::kCount);
+        for (int i = 0; i < details::kCount; ++i) {
+            if (i % 2 == 0) {
+                shapes[i] = pro::make_proxy<details::Shape>(details::Square { i });
+            } else {
+                shapes[i] = pro::make_proxy<details::Shape>(details::Rect { i, 2 });
+            }
+        }
+        benchmark::DoNotOptimize(shapes.back()->Area());
+    }
+    state.SetItemsProcessed(state.iterations() * details::kCount);
+}
+
+BENCHMARK(BM_MappedHeapLoad);
+BENCHMARK(BM_ReconstructProxies);
+#endif  // __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
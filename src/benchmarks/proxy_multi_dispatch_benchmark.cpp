@@ -0,0 +1,95 @@
+#include <proxy.hpp>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <vector>
+
+namespace proxy_multi_dispatch_benchmark_details {
+    struct Circle {
+        int r;
+    };
+    struct Rect {
+        int w;
+        int h;
+    };
+    struct Triangle {
+        int base;
+    };
+
+    struct Overlap {
+        int operator()(const Circle& a, const Circle& b) const noexcept { return a.r + b.r; }
+        int operator()(const Circle& a, const Rect& b) const noexcept { return a.r + b.w; }
+        int operator()(const Rect& a, const Circle& b) const noexcept { return a.h - b.r; }
+        int operator()(const Rect& a, const Rect& b) const noexcept { return a.w * b.h; }
+        int operator()(const Triangle& a, const Circle& b) const noexcept { return a.base - b.r; }
+        int operator()(const Triangle& a, const Triangle& b) const noexcept { return a.base * b.base; }
+        int operator()(std::nullptr_t, std::nullptr_t) const noexcept { return 0; }
+    };
+
+    using OverlapDispatch = pro::multi_dispatch<Overlap, int(), Circle, Rect, Triangle>;
+
+    struct Shape : pro::facade_builder ::add_direct_reflection<OverlapDispatch>::support_rtti::build {};
+
+    constexpr int kCount = 1000;
+
+    std::vector<pro::proxy<Shape>> make_shapes() {
+        std::vector<pro::proxy<Shape>> result(kCount);
+        unsigned seed = 12345u;
+        for (int i = 0; i < kCount; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            switch ((seed >> 16) % 3u) {
+            case 0u: result[i] = pro::make_proxy<Shape>(Circle { i }); break;
+            case 1u: result[i] = pro::make_proxy<Shape>(Rect { i, i + 1 }); break;
+            default: result[i] = pro::make_proxy<Shape>(Triangle { i }); break;
+            }
+        }
+        return result;
+    }
+
+    template <class T> const T* as(const pro::proxy<Shape>& p) { return pro::details::proxy_cast_ptr<const T>(&*p); }
+
+    // The double-visitor style this replaces: probe the left operand, then
+    // the right one, one proxy_cast at a time.
+    int overlap_by_cast(const pro::proxy<Shape>& a, const pro::proxy<Shape>& b) {
+        Overlap op;
+        if (auto l = as<Circle>(a)) {
+            if (auto r = as<Circle>(b)) { return op(*l, *r); }
+            if (auto r = as<Rect>(b)) { return op(*l, *r); }
+        } else if (auto l = as<Rect>(a)) {
+            if (auto r = as<Circle>(b)) { return op(*l, *r); }
+            if (auto r = as<Rect>(b)) { return op(*l, *r); }
+        } else if (auto l = as<Triangle>(a)) {
+            if (auto r = as<Circle>(b)) { return op(*l, *r); }
+            if (auto r = as<Triangle>(b)) { return op(*l, *r); }
+        }
+        return op(nullptr, nullptr);
+    }
+} // namespace proxy_multi_dispatch_benchmark_details
+
+namespace details = proxy_multi_dispatch_benchmark_details;
+
+static void BM_MultiDispatchTable(benchmark::State& state) {
+    const auto shapes = details::make_shapes();
+    for (auto _ : state) {
+        int sum = 0;
+        for (int i = 0; i + 1 < details::kCount; ++i) {
+            sum += pro::multi_invoke<details::OverlapDispatch>(shapes[i], shapes[i + 1]);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * (details::kCount - 1));
+}
+
+static void BM_MultiDispatchChainedCast(benchmark::State& state) {
+    const auto shapes = details::make_shapes();
+    for (auto _ : state) {
+        int sum = 0;
+        for (int i = 0; i + 1 < details::kCount; ++i) {
+            sum += details::overlap_by_cast(shapes[i], shapes[i + 1]);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * (details::kCount - 1));
+}
+
+BENCHMARK(BM_MultiDispatchTable);
+BENCHMARK(BM_MultiDispatchChainedCast);
@@ -0,0 +1,114 @@
+#include <proxy_task.hpp>
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace proxy_task_benchmark_details {
+    // Baseline: a single mutex-protected queue of std::function.
+    class function_pool {
+    public:
+        explicit function_pool(std::size_t threads) {
+            for (std::size_t i = 0; i < threads; ++i) {
+                workers_.emplace_back([this] { run(); });
+            }
+        }
+        ~function_pool() {
+            wait_idle();
+            {
+                std::lock_guard<std::mutex> lock { mutex_ };
+                stop_ = true;
+            }
+            cv_.notify_all();
+            for (auto& t : workers_) {
+                t.join();
+            }
+        }
+
+        void submit(std::function<void()> fn) {
+            {
+                std::lock_guard<std::mutex> lock { mutex_ };
+                queue_.push_back(std::move(fn));
+                ++pending_;
+            }
+            cv_.notify_one();
+        }
+        void wait_idle() {
+            std::unique_lock<std::mutex> lock { mutex_ };
+            idle_cv_.wait(lock, [this] { return pending_ == 0u; });
+        }
+
+    private:
+        void run() {
+            for (;;) {
+                std::function<void()> fn;
+                {
+                    std::unique_lock<std::mutex> lock { mutex_ };
+                    cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+                    if (queue_.empty()) {
+                        return;
+                    }
+                    fn = std::move(queue_.front());
+                    queue_.pop_front();
+                }
+                fn();
+                std::lock_guard<std::mutex> lock { mutex_ };
+                if (--pending_ == 0u) {
+                    idle_cv_.notify_all();
+                }
+            }
+        }
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::condition_variable idle_cv_;
+        std::deque<std::function<void()>> queue_;
+        std::size_t pending_ = 0u;
+        bool stop_ = false;
+        std::vector<std::thread> workers_;
+    };
+
+    constexpr int kTaskCount = 10000;
+
+    template <class Pool> void spawn(Pool& pool, std::atomic<int>& counter, int depth) {
+        counter.fetch_add(1, std::memory_order_relaxed);
+        if (depth == 0) {
+            return;
+        }
+        pool.submit([&pool, &counter, depth] { spawn(pool, counter, depth - 1); });
+        pool.submit([&pool, &counter, depth] { spawn(pool, counter, depth - 1); });
+    }
+} // namespace proxy_task_benchmark_details
+
+namespace details = proxy_task_benchmark_details;
+
+template <class Pool> void BM_ExternalSubmit(benchmark::State& state) {
+    Pool pool { static_cast<std::size_t>(state.range(0)) };
+    std::atomic<int> counter { 0 };
+    for (auto _ : state) {
+        for (int i = 0; i < details::kTaskCount; ++i) {
+            pool.submit([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+        pool.wait_idle();
+    }
+    state.SetItemsProcessed(state.iterations() * details::kTaskCount);
+}
+
+template <class Pool> void BM_RecursiveSpawn(benchmark::State& state) {
+    Pool pool { static_cast<std::size_t>(state.range(0)) };
+    std::atomic<int> counter { 0 };
+    for (auto _ : state) {
+        pool.submit([&pool, &counter] { details::spawn(pool, counter, 13); });
+        pool.wait_idle();
+    }
+    state.SetItemsProcessed(state.iterations() * ((1 << 14) - 1));
+}
+
+BENCHMARK_TEMPLATE(BM_ExternalSubmit, pro::work_stealing_pool)->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ExternalSubmit, details::function_pool)->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_RecursiveSpawn, pro::work_stealing_pool)->Arg(1)->Arg(4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_RecursiveSpawn, details::function_pool)->Arg(1)->Arg(4)->UseRealTime();
@@ -0,0 +1,353 @@
+// Compile-time benchmark of facade building. Generates synthetic facades,
+// compiles each one and reports wall time, peak memory and the template
+// instantiations of the reductions the builder is made of.
+//
+// usage: compile_bench [--cxx <compiler>] [--std <c++17|c++20>]
+//                      [--inc <include dir>] [--out <work dir>]
+//                      [--filter <substring>] [--flag <compiler flag>]...
+//
+// With clang, "specs" is the number of class template specializations in the
+// AST (-print-stats) and the per-template columns count the InstantiateClass
+// events of -ftime-trace. Either is shown as "-" when the compiler does not
+// produce it; clang front ends embedded in other tools write no time trace.
+
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+struct Options {
+    std::string cxx = "clang++";
+    std::string std = "c++17";
+    std::string inc = "inc";
+    std::string out = "/tmp/proxy_compile_bench";
+    std::string filter;
+    std::vector<std::string> flags;
+};
+
+struct Case {
+    std::string name;
+    std::function<void(std::ostream&)> generate;
+};
+
+// Templates whose instantiations are counted, by qualified name prefix.
+constexpr std::string_view kTracked[] = {
+    "pro::details::recursive_reduction<",
+    "pro::details::add_conv_reduction<",
+    "pro::details::composite_accessor_reduction<",
+    "pro::details::meta_reduction_helper<",
+};
+
+struct Result {
+    double wall_ms = 0.0;
+    double cpu_ms = 0.0;
+    long peak_kb = 0;
+    bool ok = false;
+    std::optional<std::size_t> specializations;
+    std::optional<std::array<std::size_t, std::size(kTracked)>> tracked;
+};
+
+// Implementation type with member fK(Tag<0>) ... for every convention K.
+void WriteImpl(std::ostream& os, int conventions, int overloads) {
+    os << "template <int> struct Tag {};\n";
+    os << "struct Impl {\n";
+    for (int c = 0; c < conventions; ++c) {
+        for (int o = 0; o < overloads; ++o) {
+            os << "    int f" << c << "(Tag<" << o << ">) const { return " << c + o << "; }\n";
+        }
+    }
+    os << "};\n";
+}
+
+void WriteOverloads(std::ostream& os, int overloads) {
+    for (int o = 0; o < overloads; ++o) {
+        os << (o == 0 ? "" : ", ") << "int(Tag<" << o << ">) const";
+    }
+}
+
+// Constructing the proxy is what instantiates the metadata and dispatchers.
+void WriteUse(std::ostream& os, const char* facade) {
+    os << "int use() {\n"
+       << "    static Impl impl;\n"
+       << "    pro::proxy<" << facade << "> p = &impl;\n"
+       << "    return p->f0(Tag<0>{});\n"
+       << "}\n";
+}
+
+void BuilderFacade(std::ostream& os, int conventions, int overloads) {
+    os << "#include <proxy.hpp>\n";
+    WriteImpl(os, conventions, overloads);
+    for (int c = 0; c < conventions; ++c) {
+        os << "PRO_DEF_MEM_DISPATCH(Mem" << c << ", f" << c << ");\n";
+    }
+    os << "struct Facade : pro::facade_builder\n";
+    for (int c = 0; c < conventions; ++c) {
+        os << "    ::add_convention<Mem" << c << ", ";
+        WriteOverloads(os, overloads);
+        os << ">\n";
+    }
+    os << "    ::build {};\n";
+    WriteUse(os, "Facade");
+}
+
+void DslFacade(std::ostream& os, int conventions) {
+    os << "#include <proxy.hpp>\n";
+    WriteImpl(os, conventions, 1);
+    os << "interface_def(Facade)\n";
+    for (int c = 0; c < conventions; ++c) {
+        os << "    fn_def(f" << c << ", int(Tag<0>) const);\n";
+    }
+    os << "interface_end(Facade);\n";
+    WriteUse(os, "Facade");
+}
+
+// Facade K adds facade K - 1 and one convention of its own.
+void NestedFacade(std::ostream& os, int depth) {
+    os << "#include <proxy.hpp>\n";
+    WriteImpl(os, depth + 1, 1);
+    for (int d = 0; d <= depth; ++d) {
+        os << "PRO_DEF_MEM_DISPATCH(Mem" << d << ", f" << d << ");\n";
+        os << "struct Facade" << d << " : pro::facade_builder\n";
+        if (d > 0) {
+            os << "    ::add_facade<Facade" << d - 1 << ">\n";
+        }
+        os << "    ::add_convention<Mem" << d << ", int(Tag<0>) const>\n"
+           << "    ::build {};\n";
+    }
+    os << "int use() {\n"
+       << "    static Impl impl;\n"
+       << "    pro::proxy<Facade" << depth << "> p = &impl;\n"
+       << "    return p->f0(Tag<0>{});\n"
+       << "}\n";
+}
+
+// Same facade with its proxies made through an extern facade_instance.
+void ExternFacade(std::ostream& os, int conventions) {
+    std::ostringstream builder;
+    BuilderFacade(builder, conventions, 1);
+    std::string text = builder.str();
+    text = text.substr(0, text.find("int use()"));
+    os << text
+       << "PRO_EXTERN_FACADE(Facade, Impl*);\n"
+       << "int use() {\n"
+       << "    static Impl impl;\n"
+       << "    pro::proxy<Facade> p = pro::facade_instance<Facade, Impl*>::make(&impl);\n"
+       << "    return p->f0(Tag<0>{});\n"
+       << "}\n";
+}
+
+std::vector<Case> MakeCases() {
+    std::vector<Case> cases;
+    for (int n : {1, 10, 50, 100, 200}) {
+        cases.push_back({"conventions/" + std::to_string(n), [n](std::ostream& os) { BuilderFacade(os, n, 1); }});
+    }
+    for (int n : {1, 5, 10, 20}) {
+        cases.push_back({"overloads/" + std::to_string(n), [n](std::ostream& os) { BuilderFacade(os, 1, n); }});
+    }
+    for (int n : {1, 4, 16}) {
+        cases.push_back({"add_facade_depth/" + std::to_string(n), [n](std::ostream& os) { NestedFacade(os, n); }});
+    }
+    for (int n : {20, 100}) {
+        cases.push_back({"facade_builder/" + std::to_string(n), [n](std::ostream& os) { BuilderFacade(os, n, 1); }});
+        cases.push_back({"interface_def/" + std::to_string(n), [n](std::ostream& os) { DslFacade(os, n); }});
+    }
+    for (int n : {50}) {
+        cases.push_back({"make_in_tu/" + std::to_string(n), [n](std::ostream& os) { BuilderFacade(os, n, 1); }});
+        cases.push_back({"extern_facade/" + std::to_string(n), [n](std::ostream& os) { ExternFacade(os, n); }});
+    }
+    return cases;
+}
+
+bool IsClang(const Options& options) {
+    return options.cxx.find("clang") != std::string::npos;
+}
+
+std::optional<std::string> ReadFile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        return std::nullopt;
+    }
+    return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+// Reads "<N> ClassTemplateSpecialization decls" from the -print-stats output.
+void CountSpecializations(const std::string& log, Result& result) {
+    constexpr std::string_view kStat = " ClassTemplateSpecialization decls";
+    std::size_t pos = log.find(kStat);
+    if (pos == std::string::npos) {
+        return;
+    }
+    std::size_t begin = log.find_last_not_of("0123456789", pos - 1) + 1;
+    result.specializations = std::strtoull(log.c_str() + begin, nullptr, 10);
+}
+
+// Counts the InstantiateClass events of a -ftime-trace file without a JSON
+// parser: every event is a flat object with a "name" and a "detail".
+void CountInstantiations(const std::string& trace, Result& result) {
+    constexpr std::string_view kName = "\"name\":\"InstantiateClass\"";
+    constexpr std::string_view kDetail = "\"detail\":\"";
+    std::array<std::size_t, std::size(kTracked)> tracked = {};
+    for (std::size_t pos = trace.find(kName); pos != std::string::npos; pos = trace.find(kName, pos + 1)) {
+        std::size_t end = trace.find('}', pos);
+        std::size_t detail = trace.find(kDetail, pos);
+        if (detail == std::string::npos || detail > end) {
+            continue;
+        }
+        std::string_view name = std::string_view(trace).substr(detail + kDetail.size());
+        for (std::size_t i = 0; i < std::size(kTracked); ++i) {
+            if (name.substr(0, kTracked[i].size()) == kTracked[i]) {
+                ++tracked[i];
+            }
+        }
+    }
+    result.tracked = tracked;
+}
+
+Result Compile(const Options& options, const std::string& stem) {
+    std::string object = stem + ".o";
+    std::string log = stem + ".log";
+    std::vector<std::string> args = {
+        options.cxx, "-std=" + options.std, "-I" + options.inc, "-c", stem + ".cpp", "-o", object};
+    args.insert(args.end(), options.flags.begin(), options.flags.end());
+    if (IsClang(options)) {
+        args.push_back("-ftime-trace");
+        args.push_back("-ftime-trace-granularity=0");
+        args.push_back("-Xclang");
+        args.push_back("-print-stats");
+    }
+    std::vector<char*> argv;
+    for (std::string& arg : args) {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+
+    Result result;
+    auto start = std::chrono::steady_clock::now();
+    pid_t pid = fork();
+    if (pid == 0) {
+        if (std::FILE* f = std::freopen(log.c_str(), "w", stderr); f == nullptr) {
+            _exit(127);
+        }
+        execvp(argv[0], argv.data());
+        std::perror("execvp");
+        _exit(127);
+    }
+    int status = 0;
+    rusage usage{};
+    if (pid < 0 || wait4(pid, &status, 0, &usage) != pid) {
+        return result;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    result.wall_ms = std::chrono::duration<double, std::milli>(elapsed).count();
+    result.cpu_ms = (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e3 +
+        (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e3;
+    result.peak_kb = usage.ru_maxrss;
+    result.ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    if (result.ok && IsClang(options)) {
+        if (std::optional<std::string> text = ReadFile(log)) {
+            CountSpecializations(*text, result);
+        }
+        if (std::optional<std::string> text = ReadFile(stem + ".json")) {
+            CountInstantiations(*text, result);
+        }
+    }
+    return result;
+}
+
+std::optional<Options> ParseOptions(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        std::string* target = nullptr;
+        if (arg == "--cxx") {
+            target = &options.cxx;
+        } else if (arg == "--std") {
+            target = &options.std;
+        } else if (arg == "--inc") {
+            target = &options.inc;
+        } else if (arg == "--out") {
+            target = &options.out;
+        } else if (arg == "--filter") {
+            target = &options.filter;
+        } else if (arg == "--flag") {
+            target = &options.flags.emplace_back();
+        }
+        if (target == nullptr || ++i == argc) {
+            return std::nullopt;
+        }
+        *target = argv[i];
+    }
+    return options;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::optional<Options> options = ParseOptions(argc, argv);
+    if (!options) {
+        std::cerr << "usage: " << argv[0]
+                  << " [--cxx <compiler>] [--std <c++17|c++20>] [--inc <include dir>] [--out <work dir>] [--filter <substring>] [--flag <compiler flag>]...\n";
+        return 2;
+    }
+    mkdir(options->out.c_str(), 0755);
+
+    std::printf("%-22s %10s %10s %10s %8s", "case", "wall ms", "cpu ms", "peak MB", "specs");
+    for (std::string_view name : kTracked) {
+        name.remove_prefix(std::string_view("pro::details::").size());
+        name.remove_suffix(1);
+        std::printf(" %*.*s", static_cast<int>(name.size()), static_cast<int>(name.size()), name.data());
+    }
+    std::printf("\n");
+
+    bool failed = false;
+    for (const Case& c : MakeCases()) {
+        if (c.name.find(options->filter) == std::string::npos) {
+            continue;
+        }
+        std::string stem = options->out + "/" + c.name;
+        stem[stem.rfind('/')] = '_';
+        {
+            std::ofstream source(stem + ".cpp");
+            c.generate(source);
+        }
+        Result r = Compile(*options, stem);
+        if (!r.ok) {
+            std::printf("%-22s FAILED (see %s.log)\n", c.name.c_str(), stem.c_str());
+            failed = true;
+            continue;
+        }
+        std::printf("%-22s %10.0f %10.0f %10.1f", c.name.c_str(), r.wall_ms, r.cpu_ms, r.peak_kb / 1024.0);
+        if (r.specializations) {
+            std::printf(" %8zu", *r.specializations);
+        } else {
+            std::printf(" %8s", "-");
+        }
+        for (std::size_t i = 0; i < std::size(kTracked); ++i) {
+            int width = static_cast<int>(kTracked[i].size() - std::string_view("pro::details::<").size());
+            if (r.tracked) {
+                std::printf(" %*zu", width, (*r.tracked)[i]);
+            } else {
+                std::printf(" %*s", width, "-");
+            }
+        }
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+    return failed ? 1 : 0;
+}
@@ -136,18 +136,18 @@ template <typename Tp> struct large_allocator {
     }
 };
 
-PRO_DEF_FREE_DISPATCH(MemToString, std::to_string, ToString);
-
 interface_def(TestLargeStringable);
     support_relocate(pro::constraint_level::nontrivial);
     support_copy(pro::constraint_level::nontrivial);
     add_direct_reflect(SboReflector);
-    add_conv(MemToString, std::string());
+    support_format();
 interface_end(TestLargeStringable);
 
 int main() {
     auto tos = pro::make_proxy<TestLargeStringable>(12138);
-    std::cout << ToString(*tos) << std::endl;
+    char text[32];
+    auto [text_end, ec] = pro::to_chars(std::begin(text), std::end(text), tos);
+    std::cout << std::string_view(text, text_end - text) << std::endl;
 
 
     auto low_size = pro::allocate_proxy<InfoOnlyLowSize>(large_allocator<Rectangle>(),Rectangle(1.0, 2.0));
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <proxy.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+namespace proxy_perf_map_tests_details {
+    PRO_DEF_MEM_DISPATCH(MemWordCount, WordCount);
+    PRO_DEF_MEM_DISPATCH(MemTitle, Title);
+
+    struct Page {
+        int WordCount() const noexcept { return words; }
+        const char* Title() const noexcept { return "page"; }
+        int words;
+    };
+
+    struct Document : pro::facade_builder
+        ::add_convention<MemWordCount, int() const>
+        ::add_convention<MemTitle, const char*() const>
+        ::build {};
+    // Shares the dispatcher of MemWordCount with Document.
+    struct Summary : pro::facade_builder ::add_convention<MemWordCount, int() const>::build {};
+
+    using Manager = pro::details::static_meta_manager;
+
+    template <class O, class D, class P>
+    const void* dispatcher_of() {
+        using MP = typename pro::details::overload_traits<O>::template meta_provider<false, D>;
+        return reinterpret_cast<const void*>(MP::template get<P>());
+    }
+
+    std::string name_of(const void* dispatcher) {
+        auto symbols = Manager::dispatcher_symbols();
+        auto it = std::find_if(symbols.begin(), symbols.end(), [&](auto& s) { return s.address == dispatcher; });
+        return it == symbols.end() ? std::string {} : it->name;
+    }
+} // namespace proxy_perf_map_tests_details
+
+namespace details = proxy_perf_map_tests_details;
+
+TEST(ProxyPerfMapTests, TestNamesEveryOverload) {
+    pro::proxy<details::Document> doc = pro::make_proxy_inplace<details::Document, details::Page>(details::Page { 120 });
+    ASSERT_EQ(doc->WordCount(), 120);
+
+    auto symbols = details::Manager::dispatcher_symbols();
+    ASSERT_TRUE(std::is_sorted(symbols.begin(), symbols.end(), [](auto& lhs, auto& rhs) { return lhs.address < rhs.address; }));
+    using Ptr = pro::details::inplace_ptr<details::Page>;
+    std::string facade { pro::details::static_type_token { std::in_place_type<details::Document> }->type_name };
+    std::string type { pro::details::static_type_token { std::in_place_type<details::Page> }->type_name };
+    // Possibly followed by the count of the facades sharing it.
+    std::string word_count = details::name_of(details::dispatcher_of<int() const, details::MemWordCount, Ptr>());
+    ASSERT_EQ(word_count.rfind(facade + "::proxy_perf_map_tests_details::MemWordCount<" + type + "> int () const", 0), 0u);
+    ASSERT_EQ(details::name_of(details::dispatcher_of<const char*() const, details::MemTitle, Ptr>()),
+        facade + "::proxy_perf_map_tests_details::MemTitle<" + type + "> const char *() const");
+}
+
+TEST(ProxyPerfMapTests, TestFoldSharedDispatchers) {
+    pro::proxy<details::Document> doc = pro::make_proxy_inplace<details::Document, details::Page>(details::Page { 7 });
+    pro::proxy<details::Summary> summary = pro::make_proxy_inplace<details::Summary, details::Page>(details::Page { 8 });
+    ASSERT_EQ(doc->WordCount() + summary->WordCount(), 15);
+
+    const void* shared = details::dispatcher_of<int() const, details::MemWordCount, pro::details::inplace_ptr<details::Page>>();
+    std::string name = details::name_of(shared);
+    ASSERT_EQ(name.size() - name.rfind(" (+1)"), 5u);
+    auto symbols = details::Manager::dispatcher_symbols();
+    ASSERT_EQ(std::count_if(symbols.begin(), symbols.end(), [&](auto& s) { return s.address == shared; }), 1);
+}
+
+TEST(ProxyPerfMapTests, TestWriteFile) {
+    pro::proxy<details::Document> doc = pro::make_proxy_inplace<details::Document, details::Page>(details::Page { 3 });
+    ASSERT_EQ(doc->WordCount(), 3);
+
+    const void* dispatcher = details::dispatcher_of<int() const, details::MemWordCount, pro::details::inplace_ptr<details::Page>>();
+    std::ostringstream os;
+    details::Manager::write_perf_map(os);
+    std::ostringstream line;
+    line << std::hex << reinterpret_cast<std::uintptr_t>(dispatcher) << " ";
+    std::string text = os.str();
+    ASSERT_TRUE(text.rfind(line.str(), 0) == 0 || text.find("\n" + line.str()) != std::string::npos);
+    ASSERT_NE(text.find(details::name_of(dispatcher) + "\n"), std::string::npos);
+
+    std::string path = testing::TempDir() + "proxy-perf.map";
+    ASSERT_TRUE(details::Manager::write_perf_map(path.c_str()));
+    std::ifstream file { path };
+    std::string written { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+    ASSERT_EQ(written, text);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <proxy.hpp>
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace proxy_profiling_tests_details {
+    PRO_DEF_MEM_DISPATCH(MemPush, Push);
+    PRO_DEF_MEM_DISPATCH(MemSize, Size);
+
+    struct Stack {
+        void Push(int v) {
+            if (v < 0) {
+                throw std::invalid_argument { "negative" };
+            }
+            items.push_back(v);
+        }
+        std::size_t Size() const noexcept { return items.size(); }
+        std::vector<int> items;
+    };
+    struct Tally {
+        void Push(int) noexcept { ++count; }
+        std::size_t Size() const noexcept { return count; }
+        std::size_t count = 0u;
+    };
+    template <int N>
+    struct Fixed {
+        void Push(int) noexcept {}
+        std::size_t Size() const noexcept { return N; }
+    };
+
+    struct Container : pro::facade_builder
+        ::add_convention<MemPush, void(int)>
+        ::add_convention<MemSize, std::size_t() const>
+        ::build {};
+
+    using Profiler = pro::details::dispatch_profiler;
+
+    std::vector<Profiler::entry> entries_of(const Profiler::profile_report& report, std::string_view dispatch) {
+        pro::details::static_type_token facade { std::in_place_type<Container> };
+        std::vector<Profiler::entry> result;
+        std::copy_if(report.entries.begin(), report.entries.end(), std::back_inserter(result), [&](const Profiler::entry& e) {
+            return e.facade_type->type_name == facade->type_name && e.dispatch_type->type_name.find(dispatch) != std::string_view::npos;
+        });
+        return result;
+    }
+
+    template <int... Ns>
+    std::size_t size_all(std::integer_sequence<int, Ns...>) {
+        std::size_t result = 0u;
+        ((result += pro::make_proxy<Container, Fixed<Ns>>()->Size()), ...);
+        return result;
+    }
+} // namespace proxy_profiling_tests_details
+
+namespace details = proxy_profiling_tests_details;
+
+TEST(ProxyProfilingTests, TestCountsPerConcreteType) {
+    details::Profiler::reset();
+    details::Tally tally;
+    pro::proxy<details::Container> stack = pro::make_proxy<details::Container, details::Stack>();
+    pro::proxy<details::Container> tally_ptr = &tally;
+
+    for (int i = 0; i < 3; ++i) {
+        stack->Push(i);
+    }
+    tally_ptr->Push(7);
+    std::thread worker { [] {
+        pro::proxy<details::Container> local = pro::make_proxy<details::Container, details::Stack>();
+        local->Push(1);
+        local->Push(2);
+    } };
+    worker.join();
+    ASSERT_EQ(stack->Size(), 3u);
+
+    auto report = details::Profiler::report();
+    ASSERT_GE(report.total_calls, 7u);
+    auto pushes = details::entries_of(report, "MemPush");
+    ASSERT_EQ(pushes.size(), 2u);
+    ASSERT_EQ(pushes[0].proxiable_type->type_name, pro::details::static_type_token { std::in_place_type<details::Stack> }->type_name);
+    ASSERT_EQ(pushes[0].calls, 5u);
+    ASSERT_GT(pushes[0].cycles, 0u);
+    ASSERT_FALSE(pushes[0].is_direct);
+    // Raw pointers are keyed by the pointer type, as in the registry.
+    ASSERT_EQ(pushes[1].proxiable_type->type_name, pro::details::static_type_token { std::in_place_type<details::Tally*> }->type_name);
+    ASSERT_EQ(pushes[1].calls, 1u);
+    auto sizes = details::entries_of(report, "MemSize");
+    ASSERT_EQ(sizes.size(), 1u);
+    ASSERT_EQ(sizes[0].calls, 1u);
+
+    std::ostringstream os;
+    details::Profiler::dump(os);
+    std::string text = os.str();
+    ASSERT_NE(text.find("dispatch profile: "), std::string::npos);
+    ASSERT_NE(text.find(": 6 calls, 2 types, top "), std::string::npos);
+    ASSERT_NE(text.find(std::string(pushes[1].proxiable_type->type_name) + ": 1 calls"), std::string::npos);
+
+    details::Profiler::reset();
+    ASSERT_TRUE(details::entries_of(details::Profiler::report(), "MemPush").empty());
+    ASSERT_EQ(stack->Size(), 3u);
+    sizes = details::entries_of(details::Profiler::report(), "MemSize");
+    ASSERT_EQ(sizes.size(), 1u);
+    ASSERT_EQ(sizes[0].calls, 1u);
+}
+
+// The count is taken on the way out, by an exception as well.
+TEST(ProxyProfilingTests, TestCountsCallsThatThrow) {
+    details::Profiler::reset();
+    pro::proxy<details::Container> stack = pro::make_proxy<details::Container, details::Stack>();
+    ASSERT_THROW(stack->Push(-1), std::invalid_argument);
+    stack->Push(1);
+
+    auto pushes = details::entries_of(details::Profiler::report(), "MemPush");
+    ASSERT_EQ(pushes.size(), 1u);
+    ASSERT_EQ(pushes[0].calls, 2u);
+    ASSERT_EQ(details::Profiler::dropped(), 0u);
+}
+
+// More keys than a shard starts with make it grow without losing counts.
+TEST(ProxyProfilingTests, TestGrowShards) {
+    details::Profiler::reset();
+    std::size_t total = 0u;
+    std::thread worker { [&] { total = details::size_all(std::make_integer_sequence<int, 24>{}); } };
+    worker.join();
+    ASSERT_EQ(total, 276u);
+
+    auto sizes = details::entries_of(details::Profiler::report(), "MemSize");
+    ASSERT_EQ(sizes.size(), 24u);
+    for (auto& e : sizes) {
+        ASSERT_EQ(e.calls, 1u);
+    }
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <proxy.hpp>
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+namespace proxy_registry_statistics_tests_details {
+    PRO_DEF_MEM_DISPATCH(MemRead, Read);
+
+    struct Thermometer {
+        double Read() const noexcept { return celsius; }
+        double celsius;
+    };
+
+    struct Sensor : pro::facade_builder ::add_convention<MemRead, double() const>::build {};
+    struct Logged : pro::facade_builder ::add_convention<MemRead, double() const>::build {
+        PRO_PRECOMPUTED_REGISTRY(pro::register_inplace<Thermometer>);
+    };
+    struct Unknown : pro::facade_builder ::add_convention<MemRead, double() const>::build {};
+
+    using Manager = pro::details::static_meta_manager;
+
+    template <class F>
+    const Manager::key_stats* find_key(const Manager::registry_stats& stats) {
+        pro::details::static_type_token facade { std::in_place_type<F> };
+        pro::details::static_type_token type { std::in_place_type<Thermometer> };
+        auto it = std::find_if(stats.keys.begin(), stats.keys.end(),
+            [&](const Manager::key_stats& k) { return k.facade_type == facade && k.proxiable_type == type; });
+        return it == stats.keys.end() ? nullptr : &*it;
+    }
+} // namespace proxy_registry_statistics_tests_details
+
+namespace details = proxy_registry_statistics_tests_details;
+
+// Every lookup is counted: those the runtime registry serves, those the
+// precomputed one serves and those that fail.
+TEST(ProxyRegistryStatisticsTests, TestCountEveryLookup) {
+    pro::proxy<details::Sensor> sensor = pro::make_proxy_inplace<details::Sensor, details::Thermometer>(details::Thermometer { 21.5 });
+    ASSERT_TRUE((sensor.meta_->poly_cast_meta::cast_copy<details::Sensor>(sensor).has_value()));
+    for (int i = 0; i < 2; ++i) {
+        auto logged = sensor.meta_->poly_cast_meta::cast_copy<details::Logged>(sensor);
+        ASSERT_TRUE(logged.has_value());
+        ASSERT_EQ((*logged)->Read(), 21.5);
+    }
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_FALSE((sensor.meta_->poly_cast_meta::cast_copy<details::Unknown>(sensor).has_value()));
+    }
+
+    details::Manager::registry_stats stats = details::Manager::stats();
+    const details::Manager::key_stats* registered = details::find_key<details::Sensor>(stats);
+    ASSERT_NE(registered, nullptr);
+    ASSERT_EQ(registered->entries, 1u);
+    ASSERT_EQ(registered->lookups, 1u);
+    const details::Manager::key_stats* precomputed = details::find_key<details::Logged>(stats);
+    ASSERT_NE(precomputed, nullptr);
+    ASSERT_EQ(precomputed->entries, 0u);
+    ASSERT_EQ(precomputed->lookups, 2u);
+    const details::Manager::key_stats* missed = details::find_key<details::Unknown>(stats);
+    ASSERT_NE(missed, nullptr);
+    ASSERT_EQ(missed->entries, 0u);
+    ASSERT_EQ(missed->lookups, 3u);
+    ASSERT_EQ(stats.keys.front().lookups, 3u);
+    ASSERT_GT(stats.keys.size(), stats.key_count);
+
+    std::ostringstream os;
+    details::Manager::dump(os);
+    std::string text = os.str();
+    std::string unknown = std::string(missed->facade_type->type_name) + " <- " + std::string(missed->proxiable_type->type_name);
+    ASSERT_NE(text.find(unknown + " [3 lookups]: unregistered\n"), std::string::npos);
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <proxy.hpp>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace proxy_tracing_tests_details {
+    PRO_DEF_MEM_DISPATCH(MemRun, Run);
+
+    struct Doubler {
+        int Run(int x) const noexcept { return factor * x; }
+        int factor = 2;
+    };
+    struct Failing {
+        int Run(int) const { throw std::runtime_error { "failed" }; }
+    };
+
+    struct Job : pro::facade_builder ::add_convention<MemRun, int(int) const>::build {};
+
+    using Tracer = pro::details::dispatch_tracer;
+
+    std::vector<Tracer::trace_record> drain_jobs() {
+        pro::details::static_type_token facade { std::in_place_type<Job> };
+        std::vector<Tracer::trace_record> result = Tracer::drain();
+        result.erase(std::remove_if(result.begin(), result.end(), [&](const Tracer::trace_record& r) { return !(r.site->facade_type == facade); }),
+            result.end());
+        return result;
+    }
+} // namespace proxy_tracing_tests_details
+
+namespace details = proxy_tracing_tests_details;
+
+TEST(ProxyTracingTests, TestRecordsPerThread) {
+    details::Tracer::set_sample_period(1u);
+    details::Tracer::drain();
+    pro::proxy<details::Job> p = pro::make_proxy_inplace<details::Job, details::Doubler>();
+
+    int total = p->Run(1) + p->Run(2);
+    std::thread worker { [&] { total += p->Run(3); } };
+    worker.join();
+
+    ASSERT_EQ(total, 12);
+    auto records = details::drain_jobs();
+    ASSERT_EQ(records.size(), 3u);
+    ASSERT_TRUE(std::is_sorted(records.begin(), records.end(), [](auto& lhs, auto& rhs) { return lhs.start < rhs.start; }));
+    ASSERT_EQ(records[0].thread, records[1].thread);
+    ASSERT_NE(records[0].thread, records[2].thread);
+    const auto* site = &pro::details::dispatch_profile_site_v<details::Job, false, details::MemRun, int(int) const>;
+    for (auto& r : records) {
+        ASSERT_EQ(r.site, site);
+        ASSERT_EQ(r.proxiable_type->type_name, pro::details::static_type_token { std::in_place_type<details::Doubler> }->type_name);
+    }
+    ASSERT_TRUE(details::drain_jobs().empty());
+}
+
+// The record is written on the way out, by an exception as well.
+TEST(ProxyTracingTests, TestTraceCallsThatThrow) {
+    details::Tracer::set_sample_period(1u);
+    details::Tracer::drain();
+    pro::proxy<details::Job> p = pro::make_proxy_inplace<details::Job, details::Failing>();
+
+    ASSERT_THROW(p->Run(1), std::runtime_error);
+    auto records = details::drain_jobs();
+    ASSERT_EQ(records.size(), 1u);
+    ASSERT_EQ(records[0].proxiable_type->type_name, pro::details::static_type_token { std::in_place_type<details::Failing> }->type_name);
+}
+
+TEST(ProxyTracingTests, TestSamplingAndOverrun) {
+    details::Tracer::set_sample_period(1u);
+    details::Tracer::drain();
+    pro::proxy<details::Job> p = pro::make_proxy_inplace<details::Job, details::Doubler>();
+
+    details::Tracer::set_sample_period(4u);
+    ASSERT_EQ(details::Tracer::sample_period(), 4u);
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_EQ(p->Run(i), 2 * i);
+    }
+    ASSERT_EQ(details::drain_jobs().size(), 2u);
+
+    details::Tracer::set_sample_period(1u);
+    std::uint64_t lost = details::Tracer::lost();
+    for (std::size_t i = 0; i < details::Tracer::capacity + 10u; ++i) {
+        ASSERT_EQ(p->Run(1), 2);
+    }
+    ASSERT_EQ(details::drain_jobs().size(), details::Tracer::capacity);
+    ASSERT_EQ(details::Tracer::lost() - lost, 10u);
+}
+
+TEST(ProxyTracingTests, TestChromeTrace) {
+    details::Tracer::set_sample_period(1u);
+    details::Tracer::drain();
+    pro::proxy<details::Job> p = pro::make_proxy_inplace<details::Job, details::Doubler>();
+
+    std::stringstream binary;
+    ASSERT_EQ(p->Run(5), 10);
+    details::Tracer::drain(binary);
+    ASSERT_EQ(p->Run(5), 10);
+    ASSERT_EQ(p->Run(5), 10);
+    details::Tracer::drain(binary);
+
+    std::ostringstream json;
+    ASSERT_TRUE(details::Tracer::convert_to_chrome_trace(binary, json));
+    std::string text = json.str();
+    pro::details::static_type_token facade { std::in_place_type<details::Job> };
+    pro::details::static_type_token type { std::in_place_type<details::Doubler> };
+    std::string name = "{\"name\":\"" + std::string(facade->type_name) + "::proxy_tracing_tests_details::MemRun<" + std::string(type->type_name) + ">\"";
+    std::size_t events = 0u;
+    for (auto pos = text.find(name); pos != std::string::npos; pos = text.find(name, pos + 1u)) {
+        ++events;
+    }
+    ASSERT_EQ(events, 3u);
+    ASSERT_EQ(text.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+    ASSERT_NE(text.find("\"ph\":\"X\""), std::string::npos);
+    ASSERT_NE(text.find("\"args\":{\"overload\":\"int (int) const\",\"direct\":false}"), std::string::npos);
+
+    std::istringstream truncated { binary.str().substr(0, binary.str().size() - 3u) };
+    std::ostringstream ignored;
+    ASSERT_FALSE(details::Tracer::convert_to_chrome_trace(truncated, ignored));
+}
+
+// Counts are checked against the input before anything is allocated for
+// them.
+TEST(ProxyTracingTests, TestRejectOversizedCounts) {
+    auto chunk = [](std::uint32_t name_count, std::uint32_t name_size) {
+        std::string bytes = "PROTRACE";
+        bytes.append(reinterpret_cast<const char*>(&name_count), sizeof(name_count));
+        bytes.append(reinterpret_cast<const char*>(&name_size), sizeof(name_size));
+        return bytes + "abc";
+    };
+    for (auto bytes : { chunk(0x7fffffffu, 3u), chunk(1u, 0x7fffffffu), chunk(1u, 4u) }) {
+        std::istringstream is { bytes };
+        std::ostringstream os;
+        ASSERT_FALSE(details::Tracer::convert_to_chrome_trace(is, os));
+    }
+
+    // A stream that cannot seek is read up to where it ends.
+    struct unseekable : std::stringbuf {
+        using std::stringbuf::stringbuf;
+        pos_type seekoff(off_type, std::ios_base::seekdir, std::ios_base::openmode) override { return pos_type(-1); }
+    } buffer { chunk(1u, 0x7fffffffu) };
+    std::istream is { &buffer };
+    std::ostringstream os;
+    ASSERT_FALSE(details::Tracer::convert_to_chrome_trace(is, os));
+
+    std::istringstream valid { chunk(1u, 3u) + std::string(sizeof(std::uint64_t), '\0') };
+    ASSERT_TRUE(details::Tracer::convert_to_chrome_trace(valid, os));
+}
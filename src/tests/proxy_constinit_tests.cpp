@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <proxy.hpp>
+#include <iterator>
+
+#if defined(__cpp_constinit)
+#define PRO_TEST_CONSTINIT constinit
+#elif defined(__has_cpp_attribute)
+#if __has_cpp_attribute(clang::require_constant_initialization)
+#define PRO_TEST_CONSTINIT [[clang::require_constant_initialization]]
+#endif
+#endif
+#ifndef PRO_TEST_CONSTINIT
+#define PRO_TEST_CONSTINIT
+#endif  // PRO_TEST_CONSTINIT
+
+namespace proxy_constinit_tests_details {
+    PRO_DEF_MEM_DISPATCH(MemApply, Apply);
+
+    // A table of commands set up before main, as interpreters and plugin
+    // hosts keep them.
+    struct Offset {
+        constexpr explicit Offset(int d) noexcept : delta(d) {}
+        int Apply(int x) const noexcept { return x + delta; }
+        int delta;
+    };
+    struct Affine {
+        constexpr Affine(int s, int o) noexcept : scale(s), offset(o) {}
+        int Apply(int x) const noexcept { return x * scale + offset; }
+        int scale;
+        int offset;
+    };
+
+    struct Command : pro::facade_builder ::add_convention<MemApply, int(int) const>::build {};
+    struct TrivialCommand : pro::facade_builder
+        ::add_convention<MemApply, int(int) const>
+        ::support_copy<pro::constraint_level::trivial>
+        ::support_destruction<pro::constraint_level::trivial>
+        ::build {};
+
+    Offset increment { 1 };
+    Affine doubling { 2, 0 };
+
+    PRO_TEST_CONSTINIT pro::proxy<Command> pointers[] = { &increment, &doubling, nullptr };
+    PRO_TEST_CONSTINIT pro::proxy<Command> values[] = {
+        pro::make_proxy_inplace<Command, Offset>(5),
+        pro::make_proxy_inplace<Command, Affine>(3, 1),
+    };
+    PRO_TEST_CONSTINIT const pro::proxy<TrivialCommand> trivial = &doubling;
+
+    // Not declared constinit, but constant-initialized all the same.
+    struct Negate {
+        constexpr Negate() noexcept = default;
+        int Apply(int x) const noexcept { return -x; }
+    };
+    struct Undoable : pro::facade_builder ::add_convention<MemApply, int(int) const>::build {};
+    pro::proxy<Undoable> undo = pro::make_proxy_inplace<Undoable, Negate>();
+
+    // A cursor over the table, moved by a direct convention on the pointer.
+    void Advance(Offset*& p) noexcept { ++p; }
+    bool AtEnd(Offset* const& p, const Offset* end) noexcept { return p == end; }
+    PRO_DEF_FREE_DISPATCH(FreeAdvance, Advance);
+    PRO_DEF_FREE_DISPATCH(FreeAtEnd, AtEnd);
+    struct Cursor : pro::facade_builder
+        ::add_convention<MemApply, int(int) const>
+        ::add_direct_convention<FreeAdvance, void() noexcept>
+        ::add_direct_convention<FreeAtEnd, bool(const Offset*) const noexcept>
+        ::support_copy<pro::constraint_level::nothrow>
+        ::build {};
+
+    Offset steps[] = { Offset{1}, Offset{10} };
+    PRO_TEST_CONSTINIT pro::proxy<Cursor> cursor = &steps[0];
+} // namespace proxy_constinit_tests_details
+
+namespace details = proxy_constinit_tests_details;
+
+TEST(ProxyConstinitTests, TestRawPointers) {
+    ASSERT_EQ(details::pointers[0]->Apply(4), 5);
+    ASSERT_EQ(details::pointers[1]->Apply(4), 8);
+    ASSERT_FALSE(details::pointers[2].has_value());
+    details::increment.delta = 2;
+    ASSERT_EQ(details::pointers[0]->Apply(4), 6);
+    details::increment.delta = 1;
+    ASSERT_EQ(details::trivial->Apply(6), 12);
+
+    pro::proxy<details::Command> copy = std::move(details::pointers[1]);
+    ASSERT_EQ(copy->Apply(6), 12);
+    details::pointers[1] = &details::doubling;
+    ASSERT_EQ(details::pointers[1]->Apply(6), 12);
+}
+
+TEST(ProxyConstinitTests, TestDirectOnRawPointer) {
+    const pro::proxy<details::Cursor>& view = details::cursor;
+    ASSERT_FALSE(AtEnd(view, std::end(details::steps)));
+    ASSERT_EQ(details::cursor->Apply(4), 5);
+    Advance(details::cursor);
+    ASSERT_EQ(details::cursor->Apply(4), 14);
+    pro::proxy<details::Cursor> copy = details::cursor;
+    Advance(copy);
+    ASSERT_TRUE(AtEnd(copy, std::end(details::steps)));
+    ASSERT_EQ(details::cursor->Apply(4), 14);
+}
+
+TEST(ProxyConstinitTests, TestInplaceValues) {
+    ASSERT_EQ(details::values[0]->Apply(1), 6);
+    ASSERT_EQ(details::values[1]->Apply(2), 7);
+
+    pro::proxy<details::Command> moved = std::move(details::values[1]);
+    ASSERT_EQ(moved->Apply(2), 7);
+    details::values[1] = pro::make_proxy_inplace<details::Command, details::Affine>(3, 1);
+    ASSERT_EQ(details::values[1]->Apply(2), 7);
+}
+
+// Constant initialization does not run the constructors, so the metas of the
+// stored pointer types are registered before main instead.
+TEST(ProxyConstinitTests, TestRegisteredAtStartup) {
+    using Manager = pro::details::static_meta_manager;
+    ASSERT_TRUE((Manager::registered<details::Affine*, details::TrivialCommand>.load()));
+    ASSERT_TRUE((Manager::registered<pro::details::inplace_ptr<details::Negate>, details::Undoable>.load()));
+    ASSERT_EQ(details::undo->Apply(3), -3);
+
+    pro::proxy<details::Command> command = pro::make_proxy_inplace<details::Command, details::Negate>();
+    auto cast = command.meta_->poly_cast_meta::cast_copy<details::Undoable>(command);
+    ASSERT_TRUE(cast.has_value());
+    ASSERT_EQ((*cast)->Apply(-7), 7);
+}
+
+#if __cpp_constexpr >= 201907L
+TEST(ProxyConstinitTests, TestConstexpr) {
+    static constexpr pro::proxy<details::TrivialCommand> table[] = {
+        &details::increment,
+        pro::make_proxy_inplace<details::TrivialCommand, details::Affine>(2, 5),
+    };
+    ASSERT_EQ(table[0]->Apply(1), 2);
+    ASSERT_EQ(table[1]->Apply(1), 7);
+}
+#endif  // __cpp_constexpr >= 201907L
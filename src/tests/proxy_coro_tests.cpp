@@ -0,0 +1,126 @@
+#include <proxy_coro.hpp>
+#include <gtest/gtest.h>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+#include <optional>
+#include <string>
+
+namespace proxy_coro_tests_details {
+    // Runs a coroutine eagerly and leaves its frame behind once done.
+    struct Detached {
+        struct promise_type {
+            Detached get_return_object() noexcept { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() { std::terminate(); }
+        };
+    };
+
+    // Suspends the awaiting coroutine until resume() is called.
+    struct Event {
+        struct Awaiter {
+            bool await_ready() const noexcept { return event->ready; }
+            void await_suspend(std::coroutine_handle<> h) noexcept { event->waiter = h; }
+            int await_resume() const noexcept { return event->value; }
+            Event* event;
+        };
+        Awaiter wait() noexcept { return Awaiter { this }; }
+        void resume(int v) {
+            value = v;
+            ready = true;
+            std::exchange(waiter, nullptr).resume();
+        }
+        bool ready = false;
+        int value = 0;
+        std::coroutine_handle<> waiter;
+    };
+
+    pro::coro_task<int> add_later(Event& e, int base) { co_return base + co_await e.wait(); }
+
+    pro::coro_task<std::string> describe(pro::proxy<pro::awaitable<int>> p) {
+        int v = co_await std::move(p);
+        co_return std::to_string(v);
+    }
+
+    PRO_DEF_MEM_DISPATCH(MemRead, read);
+
+    struct Source {
+        Event::Awaiter read() { return event->wait(); }
+        Event* event;
+    };
+    struct TaskSource {
+        pro::coro_task<int> read() { return add_later(*event, 100); }
+        Event* event;
+    };
+
+    struct AsyncReader : pro::facade_builder
+        ::add_convention<pro::awaitable_dispatch<MemRead>, pro::proxy<pro::awaitable<int>>()>
+        ::build {};
+
+    template <class T> Detached capture(pro::coro_task<T> task, std::optional<T>& out) { out = co_await task; }
+    template <class T> Detached capture(pro::proxy<pro::awaitable<T>> p, std::optional<T>& out) { out = co_await *p; }
+} // namespace proxy_coro_tests_details
+
+namespace details = proxy_coro_tests_details;
+
+TEST(ProxyCoroTests, TestAwaitableLayout) {
+    static_assert(sizeof(pro::proxy<pro::awaitable<int>>) <= 6u * sizeof(void*));
+    static_assert(pro::proxiable<pro::details::inplace_ptr<pro::coro_task<int>>, pro::awaitable<int>>);
+    static_assert(pro::proxiable<pro::details::inplace_ptr<std::suspend_never>, pro::awaitable<void>>);
+}
+
+TEST(ProxyCoroTests, TestAwaitTypeErased) {
+    details::Event event;
+    std::optional<int> result;
+    pro::proxy<pro::awaitable<int>> p = pro::make_proxy<pro::awaitable<int>>(event.wait());
+    details::capture(std::move(p), result);
+    ASSERT_FALSE(result.has_value());
+    event.resume(42);
+    ASSERT_EQ(result, 42);
+
+    details::Event event2;
+    std::optional<std::string> text;
+    details::capture(details::describe(pro::make_proxy<pro::awaitable<int>>(details::add_later(event2, 1))), text);
+    ASSERT_FALSE(text.has_value());
+    event2.resume(2);
+    ASSERT_EQ(text, "3");
+}
+
+TEST(ProxyCoroTests, TestAwaitableConvention) {
+    details::Event event;
+    details::Source source { &event };
+    pro::proxy<details::AsyncReader> reader = &source;
+    std::optional<int> result;
+    details::capture(reader->read(), result);
+    event.resume(7);
+    ASSERT_EQ(result, 7);
+
+    details::Event event2;
+    details::TaskSource task_source { &event2 };
+    reader = &task_source;
+    result.reset();
+    details::capture(reader->read(), result);
+    ASSERT_FALSE(result.has_value());
+    event2.resume(5);
+    ASSERT_EQ(result, 105);
+}
+
+TEST(ProxyCoroTests, TestFramesAreRecycled) {
+    details::Event warmup;
+    std::optional<int> result;
+    details::capture(details::add_later(warmup, 0), result);
+    warmup.resume(1);
+    std::size_t cached = pro::frame_pool::cached();
+    ASSERT_GE(cached, 1u);
+    for (int i = 0; i < 100; ++i) {
+        details::Event event;
+        details::capture(details::add_later(event, i), result);
+        ASSERT_EQ(pro::frame_pool::cached(), cached - 1u);
+        event.resume(1);
+        ASSERT_EQ(result, i + 1);
+        ASSERT_EQ(pro::frame_pool::cached(), cached);
+    }
+}
+#endif  // defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
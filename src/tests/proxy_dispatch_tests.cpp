@@ -1,3 +1,5 @@
+#include <cstdint>
+#include <tuple>
 #include <vector>
 
 #include <proxy.hpp>
@@ -456,4 +458,206 @@ namespace proxy_dispatch_tests {
             ASSERT_EQ(p->ToString(), "123");
         }
     }
-}
\ No newline at end of file
+
+    namespace hot_dispatch {
+        struct Shape {
+            int Area() const { return w * h; }
+            int Width() const { return w; }
+            int Height() const { return h; }
+            int w;
+            int h;
+        };
+
+        interface_def(TestFacade)
+            fn_def(Width, int() const);
+            fn_def(Height, int() const);
+            fn_def_hot(Area, int() const);
+            op_def_hot(call, int(int) const);
+        interface_end(TestFacade);
+
+        struct Callable : Shape {
+            int operator()(int v) const { return v * Area(); }
+        };
+
+        TEST(ProxyDispatchTests, TestHotDispatch) {
+            using Meta = pro::details::facade_traits<TestFacade>::meta;
+            using HotMeta = pro::details::dispatcher_meta<
+                pro::details::overload_traits<int() const>::meta_provider<false, ninf_TestFacade::inf_TestFacade::MemArea>>;
+            using ColdMeta = pro::details::dispatcher_meta<
+                pro::details::overload_traits<int() const>::meta_provider<false, ninf_TestFacade::inf_TestFacade::MemWidth>>;
+            static_assert(alignof(Meta) == 64u);
+            static_assert(std::is_base_of_v<HotMeta, Meta>);
+
+            pro::proxy<TestFacade> p = pro::make_proxy<TestFacade>(Callable { { 3, 4 } });
+            ASSERT_EQ(p->Area(), 12);
+            ASSERT_EQ(p->Width(), 3);
+            ASSERT_EQ(p->Height(), 4);
+            ASSERT_EQ((*p)(2), 24);
+            ASSERT_EQ((pro::proxy_invoke<false, ninf_TestFacade::inf_TestFacade::MemArea, int() const>(p)), 12);
+
+            const Meta& meta = pro::details::proxy_helper<TestFacade>::get_meta(p);
+            auto base = reinterpret_cast<std::uintptr_t>(&meta);
+            auto hot = reinterpret_cast<std::uintptr_t>(static_cast<const HotMeta*>(&meta));
+            auto cold = reinterpret_cast<std::uintptr_t>(static_cast<const ColdMeta*>(&meta));
+            ASSERT_EQ(base % 64u, 0u);
+            ASSERT_EQ(hot, base);
+            ASSERT_GT(cold, hot);
+        }
+    }
+
+    namespace embedded_dispatch {
+        PRO_DEF_MEM_DISPATCH(MemArea, Area);
+        PRO_DEF_MEM_DISPATCH(MemWidth, Width);
+        PRO_DEF_MEM_DISPATCH(MemHeight, Height);
+
+        struct Shape {
+            int Area() const { return w * h; }
+            int Width() const { return w; }
+            int Height() const { return h; }
+            int w;
+            int h;
+        };
+
+        using Builder = pro::facade_builder ::add_convention<MemWidth, int() const>::add_convention<MemHeight,
+            int() const>::add_hot_convention<MemArea, int() const>::support_copy<pro::constraint_level::nontrivial>;
+        struct PlainFacade : Builder ::build {};
+        struct EmbeddedFacade : Builder ::embed_dispatchers<2>::build {};
+
+        // Hotness is not part of the identity of a convention: adding a facade
+        // merges into the convention of the same dispatch, which stays hot.
+        struct MergedFacade : pro::facade_builder ::add_convention<MemArea, int() const>::add_facade<PlainFacade>::build {};
+        static_assert(std::tuple_size_v<MergedFacade::convention_types> == 3u);
+        static_assert(pro::details::is_hot_conv<std::tuple_element_t<0u, MergedFacade::convention_types>>);
+        static_assert(std::is_same_v<std::tuple_element_t<0u, MergedFacade::convention_types>::dispatch_type, MemArea>);
+
+        template <class D> using MetaOf = pro::details::dispatcher_meta<
+            pro::details::overload_traits<int() const>::meta_provider<false, D>>;
+
+        TEST(ProxyDispatchTests, TestEmbeddedDispatchers) {
+            using MetaPtr = pro::details::facade_traits<EmbeddedFacade>::meta_ptr_type;
+            static_assert(EmbeddedFacade::constraints::embedded_dispatchers == 2u);
+            static_assert(sizeof(pro::proxy<EmbeddedFacade>) == sizeof(pro::proxy<PlainFacade>) + 2u * sizeof(void*));
+            static_assert(pro::details::embeds_dispatcher<MetaPtr, MetaOf<MemArea>>);
+            static_assert(pro::details::embeds_dispatcher<MetaPtr, MetaOf<MemWidth>>);
+            static_assert(!pro::details::embeds_dispatcher<MetaPtr, MetaOf<MemHeight>>);
+
+            pro::proxy<EmbeddedFacade> p = pro::make_proxy<EmbeddedFacade>(Shape { 3, 4 });
+            ASSERT_EQ(p->Area(), 12);
+            ASSERT_EQ(p->Width(), 3);
+            ASSERT_EQ(p->Height(), 4);
+
+            pro::proxy<EmbeddedFacade> copy = p;
+            ASSERT_EQ(copy->Area(), 12);
+            pro::proxy<EmbeddedFacade> moved = std::move(p);
+            ASSERT_FALSE(p.has_value());
+            ASSERT_EQ(moved->Width(), 3);
+
+            Shape shape { 5, 6 };
+            moved = &shape;
+            ASSERT_EQ(moved->Area(), 30);
+
+            pro::proxy<MergedFacade> merged = pro::make_proxy<MergedFacade>(Shape { 2, 7 });
+            ASSERT_EQ(merged->Area(), 14);
+            ASSERT_EQ((pro::proxy_invoke<false, MemArea, int() const>(merged)), 14);
+        }
+    }
+    namespace sealed_dispatch {
+        struct Circle {
+            int Area() const { return 3 * r * r; }
+            int operator()(int v) const { return v + r; }
+            int r;
+        };
+        struct Square {
+            int Area() const { return a * a; }
+            int operator()(int v) const { return v * a; }
+            int a;
+        };
+        struct Big {
+            int Area() const { return static_cast<int>(sizeof(data)); }
+            int operator()(int v) const { return v - 1; }
+            char data[256];
+        };
+
+        interface_def(TestFacade)
+            fn_def(Area, int() const);
+            op_def(call, int(int) const);
+            support_copy(pro::constraint_level::nontrivial);
+            seal(Circle, Square, Big);
+        interface_end(TestFacade);
+
+        TEST(ProxyDispatchTests, TestSealedDispatch) {
+            using MetaPtr = pro::details::facade_traits<TestFacade>::meta_ptr_type;
+            static_assert(pro::details::is_sealed_meta_ptr<MetaPtr>);
+            static_assert(sizeof(MetaPtr) == 1u);
+            static_assert(pro::proxiable<Circle*, TestFacade>);
+
+            pro::proxy<TestFacade> p = pro::make_proxy<TestFacade>(Circle { 2 });
+            ASSERT_EQ(p->Area(), 12);
+            ASSERT_EQ((*p)(1), 3);
+            pro::proxy<TestFacade> copy = p;
+            ASSERT_EQ(copy->Area(), 12);
+
+            p = pro::make_proxy<TestFacade>(Square { 5 });
+            ASSERT_EQ(p->Area(), 25);
+            ASSERT_EQ((*p)(2), 10);
+            ASSERT_EQ(copy->Area(), 12);
+
+            p = pro::make_proxy<TestFacade>(Big {});
+            ASSERT_EQ(p->Area(), 256);
+            ASSERT_EQ((*p)(5), 4);
+
+            Square square { 7 };
+            p = &square;
+            ASSERT_EQ(p->Area(), 49);
+            p.reset();
+            ASSERT_FALSE(p.has_value());
+        }
+
+        struct BuiltFacade : pro::facade_builder
+            ::add_convention<pro::operator_dispatch<pro::operator_call>, int(int) const>
+            ::seal<Circle, Square>
+            ::support_copy<pro::constraint_level::nontrivial>
+            ::build {};
+
+        TEST(ProxyDispatchTests, TestSealedBuilder) {
+            static_assert(std::is_same_v<BuiltFacade::sealed_types, std::tuple<Circle, Square>>);
+            pro::proxy<BuiltFacade> p = pro::make_proxy<BuiltFacade>(Square { 3 });
+            ASSERT_EQ((*p)(4), 12);
+            pro::proxy<BuiltFacade> q = std::move(p);
+            ASSERT_EQ((*q)(1), 3);
+            ASSERT_EQ((pro::proxy_invoke_expect<Square, pro::operator_dispatch<pro::operator_call>, int(int) const>(q, 2)), 6);
+        }
+    }
+
+    namespace shared_dispatchers {
+        PRO_DEF_MEM_DISPATCH(MemWhich, Which);
+
+        struct Target {
+            int Which() & { return 1; }
+            int Which() const& { return 2; }
+            int Which() && { return 3; }
+        };
+
+        struct Probe : pro::facade_builder
+            ::add_convention<MemWhich, int() &, int() const&, int() &&>
+            ::build {};
+
+        // Every pointer type shares the dispatchers of Target, which must still
+        // see the object the way dereferencing that pointer type does.
+        TEST(ProxyDispatchTests, TestSharedDispatchersKeepQualifiers) {
+            Target target;
+            pro::proxy<Probe> raw = &target;
+            pro::proxy<Probe> inplace = pro::make_proxy_inplace<Probe, Target>();
+            pro::proxy<Probe> unique = std::make_unique<Target>();
+            const pro::proxy<Probe>& const_inplace = inplace;
+
+            ASSERT_EQ(raw->Which(), 1);
+            ASSERT_EQ(inplace->Which(), 1);
+            ASSERT_EQ(unique->Which(), 1);
+            ASSERT_EQ(const_inplace->Which(), 2);
+            ASSERT_EQ(std::move(*raw).Which(), 1);
+            ASSERT_EQ(std::move(*unique).Which(), 1);
+            ASSERT_EQ(std::move(*inplace).Which(), 3);
+        }
+    }
+}
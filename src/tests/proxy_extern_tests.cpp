@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <proxy.hpp>
+#include <memory>
+#include <string>
+
+namespace proxy_extern_tests_details {
+    PRO_DEF_MEM_DISPATCH(MemName, Name);
+
+    struct Named : pro::facade_builder ::add_convention<MemName, std::string() const>::support_copy<pro::constraint_level::nontrivial>::build {};
+    struct Unique : pro::facade_builder ::add_convention<MemName, std::string() const>::build {};
+
+    struct Cat {
+        std::string Name() const { return "cat"; }
+    };
+    struct Dog {
+        std::string Name() const { return "dog " + name; }
+        std::string name;
+    };
+
+    using DogPtr = std::unique_ptr<Dog>;
+} // namespace proxy_extern_tests_details
+
+// As it would appear in a shared header ...
+PRO_EXTERN_FACADE(proxy_extern_tests_details::Named, proxy_extern_tests_details::Cat, proxy_extern_tests_details::Dog,
+    proxy_extern_tests_details::Dog*);
+PRO_EXTERN_FACADE(proxy_extern_tests_details::Unique, proxy_extern_tests_details::DogPtr);
+
+namespace details = proxy_extern_tests_details;
+
+TEST(ProxyExternTests, TestMakeValue) {
+    pro::proxy<details::Named> cat = pro::facade_instance<details::Named, details::Cat>::make({});
+    pro::proxy<details::Named> dog = pro::facade_instance<details::Named, details::Dog>::make({ "rex" });
+    ASSERT_EQ(cat->Name(), "cat");
+    ASSERT_EQ(dog->Name(), "dog rex");
+    pro::proxy<details::Named> copy = dog;
+    ASSERT_EQ(copy->Name(), "dog rex");
+}
+
+TEST(ProxyExternTests, TestMakePointer) {
+    details::Dog dog { "rex" };
+    pro::proxy<details::Named> p = pro::facade_instance<details::Named, details::Dog*>::make(&dog);
+    dog.name = "max";
+    ASSERT_EQ(p->Name(), "dog max");
+
+    pro::proxy<details::Unique> u = pro::facade_instance<details::Unique, details::DogPtr>::make(std::make_unique<details::Dog>(details::Dog { "bo" }));
+    ASSERT_EQ(u->Name(), "dog bo");
+}
+
+// ... and in the one translation unit that owns the definitions.
+PRO_INSTANTIATE_FACADE(proxy_extern_tests_details::Named, proxy_extern_tests_details::Cat, proxy_extern_tests_details::Dog,
+    proxy_extern_tests_details::Dog*);
+PRO_INSTANTIATE_FACADE(proxy_extern_tests_details::Unique, proxy_extern_tests_details::DogPtr);
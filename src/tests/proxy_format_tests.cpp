@@ -0,0 +1,93 @@
+#if __has_include(<fmt/format.h>)
+#define FMT_HEADER_ONLY
+#include <fmt/format.h>
+#endif  // __has_include(<fmt/format.h>)
+#include <gtest/gtest.h>
+#include <proxy.hpp>
+#include <string>
+#include <string_view>
+
+namespace proxy_format_tests_details {
+    struct Formattable : pro::facade_builder ::support_format ::build {};
+
+    struct Point {
+        void format_to(pro::format_sink& sink) const {
+            sink.push_back('(');
+            pro::details::format_value(sink, x);
+            sink.append(", ");
+            pro::details::format_value(sink, y);
+            sink.push_back(')');
+        }
+        int x;
+        int y;
+    };
+
+    interface_def(Loggable);
+        support_format();
+    interface_end(Loggable);
+
+    template <class F> std::string format_all(const pro::proxy<F>& p, std::size_t buffer_size) {
+        std::string result;
+        char buffer[64];
+        pro::format_sink sink { buffer, buffer + buffer_size,
+            [](void* context, const char* data, std::size_t size) { static_cast<std::string*>(context)->append(data, size); }, &result };
+        pro::format_to(sink, p);
+        sink.flush();
+        return result;
+    }
+} // namespace proxy_format_tests_details
+
+namespace details = proxy_format_tests_details;
+
+TEST(ProxyFormatTests, TestBuiltinTypes) {
+    char buffer[32];
+    pro::proxy<details::Formattable> p = pro::make_proxy<details::Formattable>(-12345);
+    auto [end, ec] = pro::to_chars(buffer, buffer + sizeof(buffer), p);
+    ASSERT_EQ(ec, std::errc {});
+    ASSERT_EQ(std::string_view(buffer, end - buffer), "-12345");
+
+    p = pro::make_proxy<details::Formattable>(true);
+    ASSERT_EQ(details::format_all(p, 64u), "true");
+    p = pro::make_proxy<details::Formattable>(0.5);
+    ASSERT_EQ(details::format_all(p, 64u), "0.5");
+    p = pro::make_proxy<details::Formattable>(std::string_view { "hello" });
+    ASSERT_EQ(details::format_all(p, 64u), "hello");
+    p = pro::make_proxy<details::Formattable>(std::string { "world" });
+    ASSERT_EQ(details::format_all(p, 64u), "world");
+    p = pro::make_proxy<details::Formattable>('c');
+    ASSERT_EQ(details::format_all(p, 64u), "c");
+}
+
+TEST(ProxyFormatTests, TestCustomTypeAndDsl) {
+    pro::proxy<details::Formattable> p = pro::make_proxy<details::Formattable>(details::Point { 3, -4 });
+    ASSERT_EQ(details::format_all(p, 64u), "(3, -4)");
+    pro::proxy<details::Loggable> q = pro::make_proxy<details::Loggable>(details::Point { 1, 2 });
+    ASSERT_EQ(details::format_all(q, 64u), "(1, 2)");
+}
+
+TEST(ProxyFormatTests, TestSmallBuffers) {
+    pro::proxy<details::Formattable> p = pro::make_proxy<details::Formattable>(std::string_view { "a fairly long message" });
+    ASSERT_EQ(details::format_all(p, 1u), "a fairly long message");
+    ASSERT_EQ(details::format_all(p, 4u), "a fairly long message");
+
+    char buffer[8];
+    auto [end, ec] = pro::to_chars(buffer, buffer + sizeof(buffer), p);
+    ASSERT_EQ(ec, std::errc::value_too_large);
+    ASSERT_EQ(end, buffer + sizeof(buffer));
+
+    pro::format_sink sink { buffer, buffer + sizeof(buffer) };
+    pro::format_to(sink, p);
+    ASSERT_TRUE(sink.truncated());
+    ASSERT_EQ(sink.size(), 21u);
+    ASSERT_EQ(std::string_view(buffer, sizeof(buffer)), "a fairly");
+}
+
+#ifdef FMT_VERSION
+TEST(ProxyFormatTests, TestFmtAdapter) {
+    pro::proxy<details::Formattable> p = pro::make_proxy<details::Formattable>(details::Point { 7, 8 });
+    ASSERT_EQ(fmt::format("p = {}", p), "p = (7, 8)");
+    std::string long_text(300u, 'x');
+    p = pro::make_proxy<details::Formattable>(std::string_view { long_text });
+    ASSERT_EQ(fmt::format("{}", p), long_text);
+}
+#endif  // FMT_VERSION
@@ -0,0 +1,113 @@
+#include <proxy_function.hpp>
+#include <gtest/gtest.h>
+#include <array>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace proxy_function_tests_details {
+    int add(int a, int b) { return a + b; }
+
+    struct Counter {
+        int operator()() & { return ++value; }
+        int operator()() const& { return -1; }
+        int value = 0;
+    };
+} // namespace proxy_function_tests_details
+
+namespace details = proxy_function_tests_details;
+
+TEST(ProxyFunctionTests, TestTraits) {
+    static_assert(std::is_copy_constructible_v<pro::function<void()>>);
+    static_assert(!std::is_copy_constructible_v<pro::move_only_function<void()>>);
+    static_assert(std::is_nothrow_move_constructible_v<pro::move_only_function<void()>>);
+    static_assert(sizeof(pro::function<void()>) <= 48u);
+    static_assert(sizeof(pro::function<void(), 8u>) == 2u * sizeof(void*));
+    static_assert(noexcept(std::declval<pro::function<int() noexcept>&>()()));
+    static_assert(noexcept(std::declval<const pro::function<int() noexcept>&>()()));
+    static_assert(!noexcept(std::declval<pro::function<int()>&>()()));
+    static_assert(noexcept(std::declval<const pro::move_only_function<int() const noexcept>&>()()));
+}
+
+// Only targets invocable as the signature take part in overload resolution.
+TEST(ProxyFunctionTests, TestConstrainedTargets) {
+    static_assert(!std::is_constructible_v<pro::function<void()>, int>);
+    static_assert(!std::is_constructible_v<pro::function<int(int)>, int (*)(const char*)>);
+    static_assert(!std::is_constructible_v<pro::function<int(int)>, details::Counter&>);
+    static_assert(std::is_constructible_v<pro::function<int() &>, details::Counter&>);
+    static_assert(std::is_constructible_v<pro::function<int(int, int)>, decltype(&details::add)>);
+    static_assert(!std::is_assignable_v<pro::function<void()>&, int>);
+    static_assert(std::is_assignable_v<pro::function<int(int, int)>&, decltype(&details::add)>);
+    static_assert(!std::is_convertible_v<std::string, pro::move_only_function<void()>>);
+}
+
+TEST(ProxyFunctionTests, TestInvoke) {
+    pro::function<int(int, int)> f = details::add;
+    ASSERT_EQ(f(1, 2), 3);
+    f = [](int a, int b) { return a * b; };
+    ASSERT_EQ(f(3, 4), 12);
+
+    std::array<int, 64> big{};
+    big[63] = 5;
+    pro::function<int(int, int)> g = [big](int a, int b) { return a + b + big[63]; };
+    ASSERT_EQ(g(1, 1), 7);
+}
+
+// Like std::function, an unqualified signature is callable through a const
+// reference, and the target keeps its state.
+TEST(ProxyFunctionTests, TestInvokeThroughConst) {
+    pro::function<int(int)> f = [total = 0](int x) mutable { return total += x; };
+    const pro::function<int(int)>& view = f;
+    ASSERT_EQ(view(2), 2);
+    ASSERT_EQ(view(3), 5);
+    ASSERT_EQ(f(1), 6);
+    const pro::move_only_function<int()> counter{ std::in_place_type<details::Counter> };
+    ASSERT_EQ(counter(), 1);
+    ASSERT_EQ(counter(), 2);
+}
+
+TEST(ProxyFunctionTests, TestEmpty) {
+    pro::function<void()> f;
+    ASSERT_FALSE(f);
+    ASSERT_TRUE(f == nullptr);
+    void (*fp)() = nullptr;
+    pro::function<void()> g = fp;
+    ASSERT_FALSE(g);
+    g = [] {};
+    ASSERT_TRUE(g);
+    g = nullptr;
+    ASSERT_FALSE(g);
+}
+
+TEST(ProxyFunctionTests, TestCopy) {
+    pro::function<std::string()> f = [s = std::make_shared<std::string>("hello")] { return *s; };
+    pro::function<std::string()> g = f;
+    ASSERT_EQ(f(), "hello");
+    ASSERT_EQ(g(), "hello");
+    pro::function<std::string()> h = std::move(f);
+    ASSERT_FALSE(f);
+    ASSERT_EQ(h(), "hello");
+    swap(g, f);
+    ASSERT_FALSE(g);
+    ASSERT_EQ(f(), "hello");
+}
+
+TEST(ProxyFunctionTests, TestMoveOnly) {
+    pro::move_only_function<int()> f = [p = std::make_unique<int>(42)] { return *p; };
+    ASSERT_EQ(f(), 42);
+    pro::move_only_function<int()> g = std::move(f);
+    ASSERT_FALSE(f);
+    ASSERT_EQ(g(), 42);
+}
+
+TEST(ProxyFunctionTests, TestQualifiers) {
+    pro::move_only_function<int() &> f{ std::in_place_type<details::Counter> };
+    ASSERT_EQ(f(), 1);
+    ASSERT_EQ(f(), 2);
+    pro::move_only_function<int() const&> g{ std::in_place_type<details::Counter> };
+    ASSERT_EQ(std::as_const(g)(), -1);
+
+    pro::move_only_function<std::string() &&> once = [s = std::string{"once"}]() mutable { return std::move(s); };
+    ASSERT_EQ(std::move(once)(), "once");
+}
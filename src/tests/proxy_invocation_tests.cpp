@@ -248,4 +248,168 @@ namespace proxy_invocation_tests {
         ASSERT_EQ(Dump(*std::move(p)), "is_const=false, is_ref=false, value=123");
         ASSERT_EQ(Dump(*std::move(std::as_const(p))), "is_const=true, is_ref=false, value=123");
     }
-}
\ No newline at end of file
+    TEST(ProxyInvocationTests, TestInvokeExpect) {
+        struct TestFacade : pro::facade_builder ::add_convention<pro::operator_dispatch<pro::operator_call>, int(int),
+                                int(int) const>::build {};
+        struct Adder {
+            int operator()(int v) noexcept { return v + base; }
+            int operator()(int v) const noexcept { return v + base + 100; }
+            int base;
+        };
+        struct Multiplier {
+            int operator()(int v) const noexcept { return v * factor; }
+            int factor;
+        };
+        using D = pro::operator_dispatch<pro::operator_call>;
+
+        pro::proxy<TestFacade> p1 = pro::make_proxy<TestFacade>(Adder { 1 });
+        ASSERT_EQ((pro::proxy_invoke_expect<Adder, D, int(int)>(p1, 2)), 3);
+        ASSERT_EQ((pro::proxy_invoke_expect<Adder, D, int(int) const>(std::as_const(p1), 2)), 103);
+        ASSERT_EQ((pro::proxy_invoke_expect<Multiplier, D, int(int)>(p1, 2)), 3);
+
+        Adder adder { 10 };
+        pro::proxy<TestFacade> p2 = &adder;
+        ASSERT_EQ((pro::proxy_invoke_expect<Adder, D, int(int)>(p2, 2)), 12);
+        adder.base = 20;
+        ASSERT_EQ((pro::proxy_invoke_expect<Adder, D, int(int)>(p2, 2)), 22);
+
+        pro::proxy<TestFacade> p3 = pro::make_proxy<TestFacade>(Multiplier { 3 });
+        ASSERT_EQ((pro::proxy_invoke_expect<Adder, D, int(int)>(p3, 2)), 6);
+        ASSERT_EQ((pro::proxy_invoke_expect<Multiplier, D, int(int) const>(p3, 2)), 6);
+    }
+    TEST(ProxyInvocationTests, TestInlineCache) {
+        struct TestFacade : pro::facade_builder ::add_convention<pro::operator_dispatch<pro::operator_call>, int(int)>::build {};
+        using D = pro::operator_dispatch<pro::operator_call>;
+        auto make = [](int k) {
+            switch (k) {
+            case 0: return pro::make_proxy<TestFacade>([](int v) { return v; });
+            case 1: return pro::make_proxy<TestFacade>([](int v) { return v + 1; });
+            case 2: return pro::make_proxy<TestFacade>([](int v) { return v + 2; });
+            case 3: return pro::make_proxy<TestFacade>([](int v) { return v + 3; });
+            default: return pro::make_proxy<TestFacade>([](int v) { return v + 4; });
+            }
+        };
+
+        pro::inline_cache<D, int(int)> cache;
+        pro::proxy<TestFacade> p0 = make(0);
+        ASSERT_EQ(cache.invoke(p0, 10), 10);
+        ASSERT_EQ(cache.invoke(p0, 10), 10);
+        ASSERT_EQ(cache.size(), 1u);
+        ASSERT_EQ(cache.hits(), 1u);
+        ASSERT_EQ(cache.misses(), 1u);
+
+        for (int k = 1; k < 5; ++k) {
+            pro::proxy<TestFacade> p = make(k);
+            ASSERT_EQ(cache.invoke(p, 10), 10 + k);
+            ASSERT_EQ(cache.invoke(p, 10), 10 + k);
+        }
+        ASSERT_EQ(cache.size(), decltype(cache)::capacity);
+        ASSERT_EQ(cache.hits(), 5u);
+        ASSERT_EQ(cache.misses(), 5u);
+        cache.reset();
+        ASSERT_EQ(cache.size(), 0u);
+
+        int sum = 0;
+        for (int k = 0; k < 3; ++k) {
+            pro::proxy<TestFacade> p = make(k);
+            sum += PRO_CACHED_INVOKE(D, int(int), p, 1);
+        }
+        ASSERT_EQ(sum, 6);
+    }
+    // Arguments reach the target as declared: a `const T&` still refers to the
+    // caller's object, even when T is small enough to travel in registers.
+    TEST(ProxyInvocationTests, TestReferenceArgumentsKeepIdentity) {
+        struct Larger {
+            const int& operator()(const int& a, const int& b) const noexcept { return a < b ? b : a; }
+        };
+        using D = pro::operator_dispatch<pro::operator_call>;
+        using O = const int&(const int&, const int&) const noexcept;
+        using Dispatcher = decltype(pro::details::overload_traits<O>::meta_provider<false, D>::get<Larger*>());
+        static_assert(std::is_same_v<Dispatcher, const int& (*)(const std::byte&, const int&, const int&) noexcept>);
+
+        Larger larger;
+        pro::proxy<details::Callable<O>> p = &larger;
+        int a = 1, b = 2;
+        const int& r = (*p)(a, b);
+        ASSERT_EQ(&r, &b);
+        b = 0;
+        ASSERT_EQ(&(*p)(a, b), &a);
+    }
+    namespace multi_dispatch {
+        struct Circle {
+            int r;
+        };
+        struct Rect {
+            int w;
+            int h;
+        };
+        struct Triangle {};
+
+        struct Overlap {
+            int operator()(const Circle& a, const Circle& b, int scale) const { return (a.r + b.r) * scale; }
+            int operator()(const Circle& a, const Rect& b, int scale) const { return (a.r + b.w) * scale; }
+            int operator()(const Rect& a, const Circle& b, int scale) const { return -(a.h + b.r) * scale; }
+            int operator()(std::nullptr_t, std::nullptr_t, int) const { return -1; }
+        };
+        struct Grow {
+            void operator()(Circle& a, const Circle& b) const { a.r += b.r; }
+        };
+
+        using OverlapDispatch = pro::multi_dispatch<Overlap, int(int), Circle, Rect, Triangle>;
+        using GrowDispatch = pro::multi_dispatch<Grow, void(), Circle, Rect>;
+
+        struct Shape : pro::facade_builder
+            ::add_direct_reflection<OverlapDispatch>
+            ::add_direct_reflection<GrowDispatch>
+            ::build {};
+        struct Body : pro::facade_builder
+            ::add_direct_reflection<OverlapDispatch>
+            ::support_copy<pro::constraint_level::nontrivial>
+            ::build {};
+    }
+
+    TEST(ProxyInvocationTests, TestMultiDispatch) {
+        namespace md = multi_dispatch;
+        const pro::proxy<md::Shape> circle = pro::make_proxy<md::Shape>(md::Circle { 2 });
+        md::Rect rect { 3, 4 };
+        const pro::proxy<md::Shape> rect_ptr = &rect;
+        const pro::proxy<md::Body> body = pro::make_proxy<md::Body>(md::Circle { 5 });
+        const pro::proxy<md::Shape> triangle = pro::make_proxy<md::Shape>(md::Triangle {});
+        const pro::proxy<md::Shape> unlisted = pro::make_proxy<md::Shape>(0.5);
+
+        ASSERT_EQ(pro::multi_invoke<md::OverlapDispatch>(circle, circle, 1), 4);
+        ASSERT_EQ(pro::multi_invoke<md::OverlapDispatch>(circle, rect_ptr, 2), 10);
+        ASSERT_EQ(pro::multi_invoke<md::OverlapDispatch>(rect_ptr, body, 1), -9);
+        ASSERT_EQ(pro::multi_invoke<md::OverlapDispatch>(body, circle, 1), 7);
+        ASSERT_EQ(pro::multi_invoke<md::OverlapDispatch>(rect_ptr, rect_ptr, 1), -1);
+        ASSERT_EQ(pro::multi_invoke<md::OverlapDispatch>(triangle, circle, 1), -1);
+        ASSERT_EQ(pro::multi_invoke<md::OverlapDispatch>(circle, unlisted, 1), -1);
+
+        pro::proxy<md::Shape> a = pro::make_proxy<md::Shape>(md::Circle { 1 });
+        pro::proxy<md::Shape> b = pro::make_proxy<md::Shape>(md::Circle { 4 });
+        pro::multi_invoke<md::GrowDispatch>(a, b);
+        ASSERT_EQ(pro::multi_invoke<md::OverlapDispatch>(a, circle, 1), 7);
+        pro::proxy<md::Shape> r = &rect;
+        bool thrown = false;
+        try {
+            pro::multi_invoke<md::GrowDispatch>(a, r);
+        } catch (const pro::not_implemented&) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+
+        // A const pointee is not grown even through a non-const proxy.
+        const md::Circle fixed { 3 };
+        pro::proxy<md::Shape> c = &fixed;
+        thrown = false;
+        try {
+            pro::multi_invoke<md::GrowDispatch>(c, b);
+        } catch (const pro::not_implemented&) {
+            thrown = true;
+        }
+        ASSERT_TRUE(thrown);
+        ASSERT_EQ(fixed.r, 3);
+        pro::multi_invoke<md::GrowDispatch>(a, c);
+        ASSERT_EQ(pro::multi_invoke<md::OverlapDispatch>(a, c, 1), 11);
+    }
+}
@@ -0,0 +1,214 @@
+#include <gtest/gtest.h>
+#include <proxy_mmap.hpp>
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+namespace proxy_mmap_tests_details {
+    PRO_DEF_MEM_DISPATCH(MemBalance, Balance);
+    PRO_DEF_MEM_DISPATCH(MemSelf, Self);
+
+    // Ledger entries kept in a file across runs and shared between processes.
+    struct Deposit {
+        int Balance() const noexcept { return amount; }
+        const void* Self() const noexcept { return this; }
+        int amount;
+    };
+    struct Transfer {
+        int Balance() const noexcept { return amount - fee; }
+        const void* Self() const noexcept { return this; }
+        int amount;
+        int fee;
+    };
+    struct Memo {
+        int Balance() const noexcept { return 0; }
+        const void* Self() const noexcept { return this; }
+    };
+
+    struct Entry : pro::facade_builder ::add_convention<MemBalance, int() const>::add_convention<MemSelf, const void*() const>::support_copy<pro::constraint_level::nontrivial>::build {
+        PRO_PRECOMPUTED_REGISTRY(pro::register_pointer<Deposit>, pro::register_pointer<Transfer>);
+    };
+
+    // Removes the backing file once the test is done.
+    struct TempFile {
+        TempFile() {
+            char name[] = "/tmp/proxy_mmap_XXXXXX";
+            int fd = mkstemp(name);
+            close(fd);
+            unlink(name);
+            path = name;
+        }
+        ~TempFile() { unlink(path.c_str()); }
+        std::string path;
+    };
+} // namespace proxy_mmap_tests_details
+
+namespace details = proxy_mmap_tests_details;
+
+TEST(ProxyMmapTests, TestReloadWithoutReconstruction) {
+    details::TempFile file;
+    {
+        auto heap = pro::mapped_heap::open(file.path.c_str(), 4096u);
+        ASSERT_TRUE(heap.has_value());
+        ASSERT_NE(heap->emplace<details::Deposit>(details::Deposit { 9 }), nullptr);
+        ASSERT_NE(heap->emplace<details::Transfer>(details::Transfer { 12, 2 }), nullptr);
+        ASSERT_NE(heap->emplace<details::Memo>(), nullptr);
+        ASSERT_EQ(heap->size(), 3u);
+    }
+    auto heap = pro::mapped_heap::open(file.path.c_str(), 0u);
+    ASSERT_TRUE(heap.has_value());
+    ASSERT_EQ(heap->size(), 3u);
+    ASSERT_EQ(heap->capacity(), 4096u);
+    std::vector<pro::proxy<details::Entry>> entries = heap->load<details::Entry>();
+    ASSERT_EQ(entries.size(), 3u);
+    ASSERT_EQ(entries[0]->Balance(), 9);
+    ASSERT_EQ(entries[1]->Balance(), 10);
+    ASSERT_FALSE(entries[2].has_value());
+    ASSERT_TRUE(heap->contains(entries[0]->Self()));
+
+    // A second mapping lives at another address; ids and offsets still work.
+    auto other = pro::mapped_heap::open(file.path.c_str(), 0u);
+    ASSERT_TRUE(other.has_value());
+    auto again = other->load<details::Entry>();
+    ASSERT_NE(again[1]->Self(), entries[1]->Self());
+    ASSERT_EQ(again[1]->Balance(), 10);
+}
+
+TEST(ProxyMmapTests, TestAllocatorAndCapacity) {
+    details::TempFile file;
+    auto heap = pro::mapped_heap::open(file.path.c_str(), 512u);
+    ASSERT_TRUE(heap.has_value());
+    auto p = pro::allocate_proxy<details::Entry, details::Transfer>(pro::mapped_allocator<details::Transfer> { *heap }, details::Transfer { 20, 4 });
+    ASSERT_EQ(p->Balance(), 16);
+    ASSERT_TRUE(heap->contains(p->Self()));
+    ASSERT_EQ(heap->size(), 1u);
+    ASSERT_NE(heap->allocate(24u, 8u), nullptr);
+    ASSERT_EQ(heap->size(), 1u);
+
+    std::size_t stored = 0u;
+    while (heap->emplace<details::Deposit>(details::Deposit { 1 }) != nullptr) {
+        ++stored;
+    }
+    ASSERT_GT(stored, 0u);
+    ASSERT_LE(heap->used(), heap->capacity());
+    ASSERT_EQ(heap->load<details::Entry>().size(), stored + 1u);
+}
+
+TEST(ProxyMmapTests, TestReloadAllocatedProxy) {
+    details::TempFile file;
+    {
+        auto heap = pro::mapped_heap::open(file.path.c_str(), 4096u);
+        ASSERT_TRUE(heap.has_value());
+        auto p = pro::allocate_proxy<details::Entry, details::Transfer>(pro::mapped_allocator<details::Transfer> { *heap }, details::Transfer { 25, 4 });
+        ASSERT_EQ(p->Balance(), 21);
+        ASSERT_NE(heap->emplace<details::Deposit>(details::Deposit { 4 }), nullptr);
+    }
+    auto heap = pro::mapped_heap::open(file.path.c_str(), 0u);
+    ASSERT_TRUE(heap.has_value());
+    auto entries = heap->load<details::Entry>();
+    ASSERT_EQ(entries.size(), 2u);
+    ASSERT_EQ(entries[0]->Balance(), 21);
+    ASSERT_EQ(entries[1]->Balance(), 4);
+    ASSERT_TRUE(heap->contains(entries[0]->Self()));
+}
+
+// Records are checked against the heap before anything is viewed through
+// them.
+TEST(ProxyMmapTests, TestRejectCorruptRecords) {
+    details::TempFile file;
+    auto heap = pro::mapped_heap::open(file.path.c_str(), 4096u);
+    ASSERT_TRUE(heap.has_value());
+    details::Deposit* deposit = heap->emplace<details::Deposit>(details::Deposit { 9 });
+    ASSERT_NE(heap->emplace<details::Transfer>(details::Transfer { 12, 2 }), nullptr);
+    ASSERT_EQ(heap->load<details::Entry>().size(), 2u);
+
+    // The id still matches, but the stored name no longer does.
+    auto* record = reinterpret_cast<pro::details::mapped_heap_record*>(reinterpret_cast<std::byte*>(deposit)) - 1;
+    char* base = reinterpret_cast<char*>(deposit) - heap->ref(deposit).offset;
+    ++base[record->name];
+    auto entries = heap->load<details::Entry>();
+    ASSERT_EQ(entries.size(), 2u);
+    ASSERT_FALSE(entries[0].has_value());
+    ASSERT_EQ(entries[1]->Balance(), 10);
+    --base[record->name];
+
+    std::uint64_t size = record->size;
+    record->size = heap->capacity();
+    ASSERT_TRUE(heap->load<details::Entry>().empty());
+    record->size = size + 1u;
+    ASSERT_TRUE(heap->load<details::Entry>().empty());
+    record->size = size;
+    ASSERT_EQ(heap->load<details::Entry>().size(), 2u);
+
+    // A handle is checked against the record in front of it alone.
+    pro::mapped_ref ref = heap->ref(deposit);
+    ++record->check;
+    ASSERT_EQ(heap->at<details::Deposit>(ref), nullptr);
+    ASSERT_FALSE(heap->get<details::Entry>(ref).has_value());
+    ASSERT_TRUE(heap->load<details::Entry>().empty());
+    --record->check;
+    ASSERT_EQ(heap->get<details::Entry>(ref)->Balance(), 9);
+}
+
+TEST(ProxyMmapTests, TestRejectForeignFile) {
+    details::TempFile file;
+    FILE* f = fopen(file.path.c_str(), "w");
+    ASSERT_NE(f, nullptr);
+    fputs("not a proxy heap, just some text of sufficient length", f);
+    fclose(f);
+    ASSERT_FALSE(pro::mapped_heap::open(file.path.c_str(), 0u).has_value());
+}
+
+#ifdef __linux__
+// The child maps the heap on its own, at an address of its choosing, and
+// reads and extends it through handles only.
+TEST(ProxyMmapTests, TestShareBetweenProcesses) {
+    int fd = memfd_create("proxy_mmap_tests", 0);
+    ASSERT_GE(fd, 0);
+    auto heap = pro::mapped_heap::map(fd, 4096u);
+    ASSERT_TRUE(heap.has_value());
+    pro::mapped_ref deposit = heap->ref(heap->emplace<details::Deposit>(details::Deposit { 16 }));
+    pro::mapped_ref transfer = heap->ref(heap->emplace<details::Transfer>(details::Transfer { 8, 2 }));
+    pro::mapped_ref mailbox = heap->ref(heap->emplace<pro::mapped_ref>(pro::mapped_ref { 0u }));
+    auto allocated = pro::allocate_proxy<details::Entry, details::Transfer>(pro::mapped_allocator<details::Transfer> { *heap }, details::Transfer { 10, 1 });
+    pro::mapped_ref transfer_of_allocator = heap->ref(allocated->Self());
+
+    // A copy of the record and object of a deposit inside an untyped block is
+    // not a block of its own.
+    auto* block = static_cast<std::byte*>(heap->allocate(64u, 16u));
+    ASSERT_NE(block, nullptr);
+    const std::byte* original = reinterpret_cast<const std::byte*>(heap->at<details::Deposit>(deposit)) - sizeof(pro::details::mapped_heap_record);
+    std::memcpy(block, original, sizeof(pro::details::mapped_heap_record) + sizeof(details::Deposit));
+    pro::mapped_ref forged = pro::mapped_ref { heap->ref(block).offset + sizeof(pro::details::mapped_heap_record) };
+    ASSERT_EQ(heap->at<details::Deposit>(forged), nullptr);
+    ASSERT_FALSE(heap->get<details::Entry>(forged).has_value());
+
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        auto own = pro::mapped_heap::map(fd, 0u);
+        bool ok = own.has_value() && own->get<details::Entry>(deposit)->Balance() == 16 &&
+            own->get<details::Entry>(transfer)->Balance() == 6 && !own->get<details::Entry>(mailbox).has_value() &&
+            own->get<details::Entry>(transfer_of_allocator)->Balance() == 9 && !own->get<details::Entry>(forged).has_value() &&
+            own->at<details::Deposit>(transfer) == nullptr && own->at<pro::mapped_ref>(mailbox) != nullptr;
+        if (ok) {
+            *own->at<pro::mapped_ref>(mailbox) = own->ref(own->emplace<details::Deposit>(details::Deposit { 25 }));
+        }
+        _exit(ok ? 0 : 1);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status));
+    ASSERT_EQ(WEXITSTATUS(status), 0);
+    ASSERT_EQ(heap->size(), 5u);
+    ASSERT_EQ(heap->get<details::Entry>(*heap->at<pro::mapped_ref>(mailbox))->Balance(), 25);
+    close(fd);
+}
+#endif  // __linux__
+#endif  // __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <proxy.hpp>
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <tuple>
+
+namespace proxy_registry_tests_details {
+    PRO_DEF_MEM_DISPATCH(MemLength, Length);
+
+    // Texts converted between facades: a word fits inline, a paragraph only
+    // in an allocation.
+    struct Word {
+        int Length() const noexcept { return letters; }
+        int letters;
+    };
+    struct Paragraph {
+        int Length() const noexcept { return words[0] + words[1]; }
+        int words[16];
+    };
+
+    template <class T> struct CountingAllocator : std::allocator<T> {
+        using value_type = T;
+        CountingAllocator() = default;
+        template <class U> CountingAllocator(const CountingAllocator<U>&) noexcept {}
+        template <class U> struct rebind {
+            using other = CountingAllocator<U>;
+        };
+    };
+
+    struct Text : pro::facade_builder ::add_convention<MemLength, int() const>::support_copy<pro::constraint_level::nontrivial>::build {};
+    struct Measurable : pro::facade_builder ::add_convention<MemLength, int() const>::restrict_layout<2 * sizeof(void*)>::build {
+        PRO_PRECOMPUTED_REGISTRY(pro::register_inplace<Word>, pro::register_allocated<Paragraph, CountingAllocator<Paragraph>>);
+    };
+    struct Unregistered : pro::facade_builder ::add_convention<MemLength, int() const>::build {};
+    // Never constructed, so not registered at startup either.
+    struct Unconstructed : pro::facade_builder ::add_convention<MemLength, int() const>::build {};
+} // namespace proxy_registry_tests_details
+
+namespace details = proxy_registry_tests_details;
+
+TEST(ProxyRegistryTests, TestPrecomputedTable) {
+    using Registry = pro::details::facade_registry<details::Measurable>;
+    static_assert(Registry::enabled);
+    static_assert(!pro::details::facade_registry<details::Unregistered>::enabled);
+    // The registrations belong to the facade, so any translation unit that
+    // can name it sees them.
+    static_assert(std::is_same_v<details::Measurable::precomputed_registrations,
+        std::tuple<pro::register_inplace<details::Word>, pro::register_allocated<details::Paragraph, details::CountingAllocator<details::Paragraph>>>>);
+    static_assert(Registry::table.size() == 2u);
+    static_assert(Registry::table[0].hash <= Registry::table[1].hash);
+
+    auto [first, last] = Registry::equal_range(pro::details::static_type_token { std::in_place_type<details::Paragraph> });
+    ASSERT_EQ(last - first, 1);
+    ASSERT_EQ(first->type, pro::details::static_meta_manager::ptr_type::allocated);
+}
+
+// No proxy<Measurable> is constructed before the casts, so only the
+// precomputed table can know how to build one.
+TEST(ProxyRegistryTests, TestCastBeforeFirstConstruction) {
+    pro::proxy<details::Text> word = pro::make_proxy_inplace<details::Text, details::Word>(details::Word { 3 });
+    auto copied = word.meta_->poly_cast_meta::cast_copy<details::Measurable>(word);
+    ASSERT_TRUE(copied.has_value());
+    ASSERT_EQ((*copied)->Length(), 3);
+    ASSERT_TRUE(word.has_value());
+
+    auto unregistered = word.meta_->poly_cast_meta::cast_copy<details::Unconstructed>(word);
+    ASSERT_FALSE(unregistered.has_value());
+
+    details::CountingAllocator<details::Paragraph> alloc;
+    pro::proxy<details::Text> paragraph = pro::allocate_proxy<details::Text, details::Paragraph>(alloc, details::Paragraph { { 4, 5 } });
+    auto moved = paragraph.meta_->poly_cast_meta::cast_move<details::Measurable>(paragraph, std::optional(alloc));
+    ASSERT_TRUE(moved.has_value());
+    ASSERT_EQ((*moved)->Length(), 9);
+    ASSERT_FALSE(paragraph.has_value());
+
+    paragraph = pro::allocate_proxy<details::Text, details::Paragraph>(alloc, details::Paragraph { { 4, 5 } });
+    auto without_allocator = paragraph.meta_->poly_cast_meta::cast_move<details::Measurable>(paragraph);
+    ASSERT_FALSE(without_allocator.has_value());
+    ASSERT_TRUE(paragraph.has_value());
+}
+
+TEST(ProxyRegistryTests, TestStatsAndDump) {
+    pro::proxy<details::Unregistered> p = pro::make_proxy_inplace<details::Unregistered, details::Word>(details::Word { 2 });
+    ASSERT_EQ(p->Length(), 2);
+
+    using Manager = pro::details::static_meta_manager;
+    Manager::registry_stats stats = Manager::stats();
+    ASSERT_GE(stats.key_count, 1u);
+    ASSERT_GE(stats.entry_count, stats.key_count);
+    ASSERT_EQ(stats.keys.size(), stats.key_count);
+    ASSERT_GE(stats.max_probe_length, 1u);
+    ASSERT_GE(stats.mean_probe_length, 1.0);
+    ASSERT_GT(stats.total_bytes, 0u);
+    pro::details::static_type_token facade { std::in_place_type<details::Unregistered> };
+    pro::details::static_type_token type { std::in_place_type<details::Word> };
+    auto it = std::find_if(stats.keys.begin(), stats.keys.end(),
+        [&](const Manager::key_stats& k) { return k.facade_type == facade && k.proxiable_type == type; });
+    ASSERT_NE(it, stats.keys.end());
+    ASSERT_EQ(it->entries, 1u);
+
+    std::ostringstream os;
+    Manager::dump(os);
+    std::string text = os.str();
+    ASSERT_NE(text.find("registry: "), std::string::npos);
+    ASSERT_NE(text.find(std::string(facade->type_name) + " <- " + std::string(type->type_name) + ": inplace"), std::string::npos);
+}
@@ -0,0 +1,227 @@
+#include <proxy_task.hpp>
+#include <gtest/gtest.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace proxy_task_tests_details {
+    PRO_DEF_MEM_DISPATCH(MemAdd, add);
+    PRO_DEF_MEM_DISPATCH(MemValue, value);
+
+    struct Counter {
+        int add(int delta) {
+            if (delta < -10) {
+                throw std::invalid_argument("delta");
+            }
+            return value += delta;
+        }
+        void add(const std::string& s) { value += static_cast<int>(s.size()); }
+        int value;
+    };
+
+    struct Cell {
+        int& value() { return v; }
+        int v;
+    };
+
+    struct Accumulator : pro::facade_builder ::add_convention<MemAdd, int(int), void(std::string)>::build {};
+    struct Referable : pro::facade_builder ::add_convention<MemValue, int&()>::build {};
+    struct Incrementable : pro::facade_builder ::add_convention<MemAdd, int(int)>::build {};
+    struct Resettable : pro::facade_builder ::add_convention<MemAdd, int(int)>::build {};
+
+    // Too large for inline storage, so the first one is registered when it
+    // is constructed.
+    struct Journal {
+        int add(int delta) { return entries[0] += delta; }
+        int entries[32];
+    };
+    // Copying keeps a journal of its own, as a proxy built by user code in
+    // the middle of a cast.
+    struct Journaled {
+        explicit Journaled(int v) : value(v) {}
+        Journaled(Journaled&&) = default;
+        Journaled(const Journaled& rhs) : value(rhs.value) {
+            pro::proxy<Incrementable> journal = pro::make_proxy<Incrementable>(Journal {});
+            copies = journal->add(1);
+        }
+        int add(int delta) { return value += delta; }
+        int value;
+        int copies = 0;
+    };
+
+    void spawn_tree(pro::work_stealing_pool& pool, std::atomic<int>& counter, int depth) {
+        counter.fetch_add(1, std::memory_order_relaxed);
+        if (depth == 0) {
+            return;
+        }
+        pool.submit([&pool, &counter, depth] { spawn_tree(pool, counter, depth - 1); });
+        pool.submit([&pool, &counter, depth] { spawn_tree(pool, counter, depth - 1); });
+    }
+} // namespace proxy_task_tests_details
+
+namespace details = proxy_task_tests_details;
+
+TEST(ProxyTaskTests, TestTaskLayout) {
+    static_assert(sizeof(pro::proxy<pro::task>) <= 64u);
+    static_assert(std::is_nothrow_move_constructible_v<pro::proxy<pro::task>>);
+}
+
+TEST(ProxyTaskTests, TestTaskInvocation) {
+    int value = 0;
+    pro::proxy<pro::task> small = pro::make_proxy<pro::task>([&value] { value += 1; });
+    (*std::move(small))();
+    ASSERT_EQ(value, 1);
+
+    std::array<int, 32> payload{};
+    payload[31] = 41;
+    pro::proxy<pro::task> large = pro::make_proxy<pro::task>([&value, payload] { value += payload[31]; });
+    (*std::move(large))();
+    ASSERT_EQ(value, 42);
+
+    auto owned = std::make_unique<int>(7);
+    pro::proxy<pro::task> move_only = pro::make_proxy<pro::task>([&value, p = std::move(owned)] { value += *p; });
+    (*std::move(move_only))();
+    ASSERT_EQ(value, 49);
+}
+
+TEST(ProxyTaskTests, TestDequeOwnerAndThief) {
+    pro::details::task_deque deque{4u};
+    int value = 0;
+    for (int i = 0; i < 4; ++i) {
+        pro::proxy<pro::task> t = pro::make_proxy<pro::task>([&value, i] { value = value * 10 + i; });
+        ASSERT_TRUE(deque.push(t));
+    }
+    pro::proxy<pro::task> overflow = pro::make_proxy<pro::task>([] {});
+    ASSERT_FALSE(deque.push(overflow));
+    ASSERT_TRUE(overflow.has_value());
+
+    auto stolen = deque.steal();
+    ASSERT_TRUE(stolen.has_value());
+    (*std::move(stolen))();
+    auto popped = deque.pop();
+    ASSERT_TRUE(popped.has_value());
+    (*std::move(popped))();
+    ASSERT_EQ(value, 3);
+    deque.pop();
+    deque.pop();
+    ASSERT_TRUE(deque.empty());
+    ASSERT_FALSE(deque.pop().has_value());
+    ASSERT_FALSE(deque.steal().has_value());
+}
+
+TEST(ProxyTaskTests, TestPoolExternalSubmit) {
+    std::atomic<int> counter{0};
+    {
+        pro::work_stealing_pool pool{4u};
+        ASSERT_EQ(pool.size(), 4u);
+        for (int i = 0; i < 10000; ++i) {
+            pool.submit([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+        }
+        pool.wait_idle();
+        ASSERT_EQ(counter.load(), 10000);
+    }
+    ASSERT_EQ(counter.load(), 10000);
+}
+
+TEST(ProxyTaskTests, TestPoolNestedSpawn) {
+    std::atomic<int> counter{0};
+    pro::work_stealing_pool pool{4u, 16u};
+    pool.submit([&pool, &counter] { details::spawn_tree(pool, counter, 12); });
+    pool.wait_idle();
+    ASSERT_EQ(counter.load(), (1 << 13) - 1);
+}
+
+TEST(ProxyTaskTests, TestPoolConcurrentProducers) {
+    std::atomic<int> counter{0};
+    pro::work_stealing_pool pool{3u};
+    std::vector<std::thread> producers;
+    for (int i = 0; i < 4; ++i) {
+        producers.emplace_back([&pool, &counter] {
+            for (int j = 0; j < 2000; ++j) {
+                pool.submit([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+            }
+        });
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+    pool.wait_idle();
+    ASSERT_EQ(counter.load(), 8000);
+}
+
+// Casts from worker threads share the registry lock.
+TEST(ProxyTaskTests, TestConcurrentCasts) {
+    pro::proxy<details::Incrementable> registered = pro::make_proxy<details::Incrementable>(details::Counter { 0 });
+    ASSERT_EQ(registered->add(1), 1);
+    std::atomic<int> casts { 0 };
+    {
+        pro::work_stealing_pool pool{4u};
+        for (int i = 0; i < 256; ++i) {
+            pool.submit([&casts, i] {
+                pro::proxy<details::Accumulator> p = pro::make_proxy<details::Accumulator>(details::Counter { i });
+                auto cast = p.meta_->poly_cast_meta::cast_move<details::Incrementable>(p);
+                if (cast.has_value() && !p.has_value() && (*cast)->add(1) == i + 1) {
+                    casts.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        pool.wait_idle();
+    }
+    ASSERT_EQ(casts.load(), 256);
+}
+
+// The registry lock is released before the cast runs the copy constructor.
+TEST(ProxyTaskTests, TestCastRunsUserCodeUnlocked) {
+    pro::proxy<details::Resettable> registered = pro::make_proxy<details::Resettable>(details::Journaled { 0 });
+    pro::proxy<details::Incrementable> p = pro::make_proxy<details::Incrementable>(details::Journaled { 1 });
+    auto cast = p.meta_->poly_cast_meta::cast_copy<details::Resettable>(p);
+    ASSERT_TRUE(cast.has_value());
+    ASSERT_EQ((*cast)->add(1), 2);
+    ASSERT_EQ(p->add(1), 2);
+}
+
+TEST(ProxyTaskTests, TestInvokeAsync) {
+    using Call = pro::details::async_call<details::MemAdd, int(int), false, details::Accumulator, false, int>;
+    static_assert(pro::proxiable<pro::details::inplace_ptr<Call>, pro::task>);
+    pro::work_stealing_pool pool{2u};
+
+    pro::proxy<details::Accumulator> owned = pro::make_proxy<details::Accumulator>(details::Counter { 10 });
+    pro::task_future<int> f1 = pro::invoke_async<details::MemAdd, int(int)>(pool, std::move(owned), 5);
+    ASSERT_FALSE(owned.has_value());
+    ASSERT_TRUE(f1.valid());
+    ASSERT_EQ(f1.get(), 15);
+    ASSERT_FALSE(f1.valid());
+
+    details::Counter counter { 1 };
+    pro::proxy<details::Accumulator> view = &counter;
+    std::vector<pro::task_future<int>> futures(8);
+    for (auto& f : futures) {
+        f = pro::invoke_async<details::MemAdd, int(int)>(pool, view, 1);
+        f.wait();
+        ASSERT_TRUE(f.ready());
+    }
+    ASSERT_EQ(futures.back().get(), 9);
+    ASSERT_EQ(counter.value, 9);
+
+    pro::task_future<void> f2 = pro::invoke_async<details::MemAdd, void(std::string)>(pool, view, std::string("abc"));
+    f2.get();
+    ASSERT_EQ(counter.value, 12);
+
+    pro::task_future<int> f3 = pro::invoke_async<details::MemAdd, int(int)>(pool, view, -100);
+    ASSERT_THROW(f3.get(), std::invalid_argument);
+}
+
+TEST(ProxyTaskTests, TestInvokeAsyncReference) {
+    pro::work_stealing_pool pool{1u};
+    details::Cell cell { 3 };
+    pro::proxy<details::Referable> p = &cell;
+    pro::task_future<int&> f = pro::invoke_async<details::MemValue, int&()>(pool, p);
+    int& r = f.get();
+    ASSERT_EQ(&r, &cell.v);
+    r = 4;
+    ASSERT_EQ(cell.v, 4);
+}
@@ -1,19 +1,28 @@
 add_rules("mode.debug", "mode.release")
 add_requires("gtest >=1.8.1")
+add_requires("benchmark")
+
+option("cxx20")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Build in C++20 mode, enabling the coroutine support of proxy_coro.hpp")
+option_end()
+
+local cxx_std = has_config("cxx20") and "-std=c++20" or "-std=c++17"
 
 target("proxy")
     set_kind("binary")
     set_toolchains('clang')
     add_includedirs("inc")
     add_files("src/*.cpp")
-    add_cxxflags("-std=c++17","-Werror","-Wall","-Wextra","-fstrict-aliasing","-Wstrict-aliasing","-ftemplate-backtrace-limit=0")
+    add_cxxflags(cxx_std,"-Werror","-Wall","-Wextra","-fstrict-aliasing","-Wstrict-aliasing","-ftemplate-backtrace-limit=0")
 
 target("samples")
     set_kind("binary")
     set_toolchains('clang')
     add_includedirs("inc")
     add_files("src/samples/*.cpp")
-    add_cxxflags("-std=c++17","-Werror","-Wall","-Wextra","-fstrict-aliasing","-Wstrict-aliasing","-ftemplate-backtrace-limit=0")
+    add_cxxflags(cxx_std,"-Werror","-Wall","-Wextra","-fstrict-aliasing","-Wstrict-aliasing","-ftemplate-backtrace-limit=0")
 
 
 target("test")
@@ -21,5 +30,65 @@ target("test")
     set_toolchains('clang')
     add_includedirs("inc")
     add_files("src/tests/*.cpp")
-    add_cxxflags("-std=c++17","-Werror","-Wall","-Wextra","-fstrict-aliasing","-Wstrict-aliasing","-ftemplate-backtrace-limit=0")
-    add_ldflags("-lgtest")
\ No newline at end of file
+    add_cxxflags(cxx_std,"-Werror","-Wall","-Wextra","-fstrict-aliasing","-Wstrict-aliasing","-ftemplate-backtrace-limit=0")
+    add_ldflags("-lgtest")
+    add_ldflags("-lpthread")
+
+-- Diagnostics that change code shared by every translation unit are each
+-- tested in a binary of their own, built with the macro turning them on.
+target("test_perf_map")
+    set_kind("binary")
+    set_toolchains('clang')
+    add_includedirs("inc")
+    add_files("src/tests/main.cpp", "src/tests/diagnostics/proxy_perf_map_tests.cpp")
+    add_defines("PRO_PERF_MAP=1")
+    add_cxxflags(cxx_std,"-Werror","-Wall","-Wextra","-fstrict-aliasing","-Wstrict-aliasing","-ftemplate-backtrace-limit=0")
+    add_ldflags("-lgtest")
+    add_ldflags("-lpthread")
+
+target("test_profiling")
+    set_kind("binary")
+    set_toolchains('clang')
+    add_includedirs("inc")
+    add_files("src/tests/main.cpp", "src/tests/diagnostics/proxy_profiling_tests.cpp")
+    add_defines("PRO_DISPATCH_PROFILING=2")
+    add_cxxflags(cxx_std,"-Werror","-Wall","-Wextra","-fstrict-aliasing","-Wstrict-aliasing","-ftemplate-backtrace-limit=0")
+    add_ldflags("-lgtest")
+    add_ldflags("-lpthread")
+
+target("test_tracing")
+    set_kind("binary")
+    set_toolchains('clang')
+    add_includedirs("inc")
+    add_files("src/tests/main.cpp", "src/tests/diagnostics/proxy_tracing_tests.cpp")
+    add_defines("PRO_DISPATCH_TRACING=1")
+    add_cxxflags(cxx_std,"-Werror","-Wall","-Wextra","-fstrict-aliasing","-Wstrict-aliasing","-ftemplate-backtrace-limit=0")
+    add_ldflags("-lgtest")
+    add_ldflags("-lpthread")
+
+target("test_registry_statistics")
+    set_kind("binary")
+    set_toolchains('clang')
+    add_includedirs("inc")
+    add_files("src/tests/main.cpp", "src/tests/diagnostics/proxy_registry_statistics_tests.cpp")
+    add_defines("PRO_REGISTRY_STATISTICS")
+    add_cxxflags(cxx_std,"-Werror","-Wall","-Wextra","-fstrict-aliasing","-Wstrict-aliasing","-ftemplate-backtrace-limit=0")
+    add_ldflags("-lgtest")
+    add_ldflags("-lpthread")
+
+target("benchmarks")
+    set_kind("binary")
+    set_toolchains('clang')
+    add_includedirs("inc")
+    add_files("src/benchmarks/*.cpp")
+    add_packages("benchmark")
+    add_cxxflags(cxx_std,"-Werror","-Wall","-Wextra","-fstrict-aliasing","-Wstrict-aliasing","-ftemplate-backtrace-limit=0")
+    add_ldflags("-lpthread")
+
+-- Compile-time benchmark: `xmake run compile_bench [--filter <case>]`
+target("compile_bench")
+    set_kind("binary")
+    set_toolchains('clang')
+    add_files("src/compile_bench/*.cpp")
+    set_rundir("$(projectdir)")
+    add_cxxflags(cxx_std,"-Werror","-Wall","-Wextra","-fstrict-aliasing","-Wstrict-aliasing","-ftemplate-backtrace-limit=0")